@@ -0,0 +1,83 @@
+/**
+ * Measures the cost of a passing assert, through the ASSERT_* macros only. The operand is
+ * hidden from the optimizer on each iteration so that the assert is not folded away.
+ *
+ * Build with the runner, for example with the assert_bench target of the CMake build:
+ * @code make assert_bench && ./assert_bench @endcode
+ * As only the macros are used, the same file also builds with the runner of an older version,
+ * which measures the asserts as that version calls them:
+ * @code gcc -O2 -pthread -I old/eztest old/eztest/runner.c bench/assert_bench.c -lm @endcode
+ */
+#include "eztest.h"
+
+#include <stdio.h>
+#include <time.h>
+
+/** The amount of asserts of each measurement. */
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS 100000000
+#endif
+
+/** Keeps the optimizer from knowing the value of the given variable. */
+#define BENCH_HIDE(v) __asm__ volatile("" : "+r"(v))
+
+/** @return The monotonic time in ns. */
+static double bench_now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec * 1e9 + (double)t.tv_nsec;
+}
+
+/** Prints the time per iteration since the given start time. */
+static void bench_report(const char *name, const double start)
+{
+    fprintf(stderr, "%-22s %.2f ns/assert\n", name, (bench_now() - start) / BENCH_ITERATIONS);
+}
+
+TEST(Bench, EmptyLoop)
+{
+    const double start = bench_now();
+    for(int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        int v = i;
+        BENCH_HIDE(v);
+    }
+    bench_report("empty loop", start);
+}
+
+TEST(Bench, Equal)
+{
+    const double start = bench_now();
+    for(int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        int v = i;
+        BENCH_HIDE(v);
+        ASSERT_EQ(v, i);
+    }
+    bench_report("ASSERT_EQ(int)", start);
+}
+
+TEST(Bench, Less)
+{
+    const double start = bench_now();
+    for(unsigned int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        unsigned int v = i;
+        BENCH_HIDE(v);
+        ASSERT_LT(v, (unsigned int)BENCH_ITERATIONS);
+    }
+    bench_report("ASSERT_LT(unsigned)", start);
+}
+
+TEST(Bench, True)
+{
+    const double start = bench_now();
+    for(int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        int v = i;
+        BENCH_HIDE(v);
+        ASSERT_IS_TRUE(v >= 0);
+    }
+    bench_report("ASSERT_IS_TRUE", start);
+}
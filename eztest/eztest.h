@@ -9,10 +9,21 @@
 #ifndef EZTEST_H
 #define EZTEST_H
 
+#ifdef TEST_RUNNER
+// The runner uses POSIX.1-2008 functions and madvise, which are hidden by strict modes such as -std=c11.
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+#endif
+
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <math.h>
+#include <stdio.h>
 
 struct unit_test
 {
@@ -22,6 +33,15 @@ struct unit_test
     void (*teardown_fn)();
     void (*run_fn)();
 
+    /** Runs a parameterized test with the given row, @code NULL @endcode for other tests. */
+    void (*run_param_fn)(const void *param);
+    /** The rows of a parameterized test, or the row of one of its instances. */
+    const void *params;
+    /** The size of each row of a parameterized test. */
+    size_t param_size;
+    /** The amount of rows of a parameterized test, each row is run as its own test. */
+    size_t param_count;
+
     /** Marks each unit test: used for test discovery. */
     uint64_t marker;
 };
@@ -39,6 +59,21 @@ struct unit_test
 
 #define EZTEST_BASE_TEST_NAME "eztest_base_test"
 
+/** The test name of the entries registering the suite setup functions. */
+#define EZTEST_SETUP_SUITE_NAME "eztest_setup_suite"
+
+/** The test name of the entries registering the suite teardown functions. */
+#define EZTEST_TEARDOWN_SUITE_NAME "eztest_teardown_suite"
+
+/** The test name of the entries registering the snapshot setup functions. */
+#define EZTEST_SNAPSHOT_SETUP_NAME "eztest_snapshot_setup"
+
+/** The test name of the entries registering the environment setup functions. */
+#define EZTEST_ENVIRONMENT_SETUP_NAME "eztest_environment_setup"
+
+/** The test name of the entries registering the environment teardown functions. */
+#define EZTEST_ENVIRONMENT_TEARDOWN_NAME "eztest_environment_teardown"
+
 #define EZTEST_RUN_FN_NAME(suite, name) run_##suite##_##name
 
 #define EZTEST_SETUP_FN_NAME(suite) setup_##suite
@@ -47,6 +82,24 @@ struct unit_test
 
 #define EZTEST_STRUCT_NAME(suite, name) struct_##suite##_##name
 
+#define EZTEST_PARAM_FN_NAME(suite, name) run_param_##suite##_##name
+
+#define EZTEST_PROPERTY_FN_NAME(suite, name) property_##suite##_##name
+
+#define EZTEST_FUZZ_FN_NAME(suite, name) fuzz_##suite##_##name
+
+#define EZTEST_DATA_FN_NAME(suite, name) data_##suite##_##name
+
+#define EZTEST_RECORD_FN_NAME(suite, name) record_##suite##_##name
+
+#define EZTEST_FIXTURE_NAME(suite) fixture_##suite
+
+#define EZTEST_FIXTURE_SETUP_FN_NAME(suite) fixture_setup_##suite
+
+#define EZTEST_FIXTURE_TEARDOWN_FN_NAME(suite) fixture_teardown_##suite
+
+#define EZTEST_FIXTURE_BODY_FN_NAME(suite, name) body_##suite##_##name
+
 /**
  * Initializes the setup function for the given suite.
  *
@@ -63,6 +116,86 @@ struct unit_test
  */
 #define TEARDOWN(suite) static void EZTEST_TEARDOWN_FN_NAME(suite)(void)
 
+/**
+ * Initializes the one-time setup function for the given suite. It runs once, before the first
+ * test of the suite that is run. It does not run when every test of the suite is skipped.
+ * Failing asserts in the function are reported as failures of that first test.
+ *
+ * @param suite The name of the test suite that this setup function belongs.
+ * @note Each suite should only have one (1) suite setup function.
+ */
+#define SETUP_SUITE(suite)\
+    static void EZTEST_RUN_FN_NAME(suite, eztest_setup_suite)(void);\
+    EZTEST_UNIT_TEST_STRUCT(suite, eztest_setup_suite);\
+    static void EZTEST_RUN_FN_NAME(suite, eztest_setup_suite)(void)
+
+/**
+ * Initializes the one-time teardown function for the given suite. It runs once, after the last
+ * test of the suite that is run. It does not run when every test of the suite is skipped.
+ * Failing asserts in the function are reported as failures of that last test.
+ *
+ * @param suite The name of the test suite that this teardown function belongs.
+ * @note Each suite should only have one (1) suite teardown function.
+ */
+#define TEARDOWN_SUITE(suite)\
+    static void EZTEST_RUN_FN_NAME(suite, eztest_teardown_suite)(void);\
+    EZTEST_UNIT_TEST_STRUCT(suite, eztest_teardown_suite);\
+    static void EZTEST_RUN_FN_NAME(suite, eztest_teardown_suite)(void)
+
+/**
+ * Initializes the snapshot setup function for the given suite. It runs once in the runner process,
+ * before the first test of the suite that is run, and each test of the suite then runs in its own
+ * forked process. The forked process shares the state built by the setup copy-on-write, so every
+ * test starts from the same state however the tests before it changed theirs. A test that crashes
+ * the process only fails that test.
+ *
+ * @param suite The name of the test suite that this setup function belongs.
+ * @note Each suite should only have one (1) snapshot setup function. State that should not be
+ *       rebuilt for the next run of the suite is released with TEARDOWN_SUITE.
+ */
+#define SNAPSHOT_SETUP(suite)\
+    static void EZTEST_RUN_FN_NAME(suite, eztest_snapshot_setup)(void);\
+    EZTEST_UNIT_TEST_STRUCT(suite, eztest_snapshot_setup);\
+    static void EZTEST_RUN_FN_NAME(suite, eztest_snapshot_setup)(void)
+
+/**
+ * Initializes a setup function for the whole test binary. Environment setup functions run once
+ * per process, in the order they are discovered, before the first test that is run. Data that
+ * the tests only read should be placed in memory from @see eztest_shared_alloc(size);
+ * Failing asserts in the function are reported as failures of the first test.
+ *
+ * @param name The name of the environment, it must follow C naming rules and be unique.
+ */
+#define ENVIRONMENT_SETUP(name)\
+    static void EZTEST_RUN_FN_NAME(name, eztest_environment_setup)(void);\
+    EZTEST_UNIT_TEST_STRUCT(name, eztest_environment_setup);\
+    static void EZTEST_RUN_FN_NAME(name, eztest_environment_setup)(void)
+
+/**
+ * Initializes a teardown function for the whole test binary. Environment teardown functions run
+ * once per process, in the reverse order of discovery, after the last test that is run.
+ * Failing asserts in the function are reported as failures of the last test.
+ *
+ * @param name The name of the environment, it must follow C naming rules and be unique.
+ */
+#define ENVIRONMENT_TEARDOWN(name)\
+    static void EZTEST_RUN_FN_NAME(name, eztest_environment_teardown)(void);\
+    EZTEST_UNIT_TEST_STRUCT(name, eztest_environment_teardown);\
+    static void EZTEST_RUN_FN_NAME(name, eztest_environment_teardown)(void)
+
+/**
+ * Allocates zeroed memory for data built by an environment setup function. The memory is
+ * writable until the environment setup functions have run, then it is made read-only for
+ * the tests: a test writing to it gets a segmentation fault. The memory is a shared mapping,
+ * so processes forked by the runner read the same pages instead of copies, and it is
+ * unmapped after the environment teardown functions have run.
+ *
+ * @param size The amount of bytes to allocate.
+ * @return A pointer to the memory, aligned to 64 bytes, or @code NULL @endcode on failure
+ *         or when called outside of an environment setup function.
+ */
+void *eztest_shared_alloc(size_t size);
+
 #define EZTEST_UNIT_TEST_STRUCT(suite, name)\
     static struct unit_test EZTEST_STRUCT_NAME(suite, name) __attribute__ ((used, section(".eztest"), aligned(1))) = {\
         .test_name=#name,\
@@ -109,22 +242,331 @@ struct unit_test
     EZTEST_FULL_UNIT_TEST_STRUCT(suite, name);\
     static void EZTEST_RUN_FN_NAME(suite, name)(void)
 
-void assert_is_null(const void *value, char *file, int line);
+/**
+ * Initializes a new parameterized unit test. Each row of the table is run as its own test,
+ * named after the test and the index of the row, like "name/3". The rows share the one test
+ * function, in which the row is available as @code const type *param @endcode .
+ *
+ * @param suite The name of the test suite that this test belongs.
+ * @param name  The name of the test.
+ * @param type  The type of the rows.
+ * @param table A static array of the rows, it must be declared before the test.
+ * @note        Suite and test-names must follow C naming rules.
+ *              Suite and test-name combination must be unique for the project.
+ */
+#define TEST_P(suite, name, type, table)\
+    _Static_assert(sizeof((table)[0]) == sizeof(type), "The rows of " #table " are not of type " #type);\
+    static void EZTEST_RUN_FN_NAME(suite, name)(const type *param);\
+    static void EZTEST_PARAM_FN_NAME(suite, name)(const void *param)\
+    {\
+        EZTEST_RUN_FN_NAME(suite, name)(param);\
+    }\
+    static struct unit_test EZTEST_STRUCT_NAME(suite, name) __attribute__ ((used, section(".eztest"), aligned(1))) = {\
+        .test_name=#name,\
+        .test_suite=#suite,\
+        .setup_fn = NULL,\
+        .teardown_fn = NULL,\
+        .run_fn = NULL,\
+        .run_param_fn = EZTEST_PARAM_FN_NAME(suite, name),\
+        .params = (table),\
+        .param_size = sizeof((table)[0]),\
+        .param_count = sizeof(table) / sizeof((table)[0]),\
+        .marker = EZTEST_MARKER\
+    };\
+    static void EZTEST_RUN_FN_NAME(suite, name)(const type *param)
+
+/** The kinds of values generated for a property test. */
+enum eztest_gen_kind
+{
+    /** An int64_t, in args[i].i. */
+    EZTEST_GEN_INT,
+    /** A double, in args[i].f. */
+    EZTEST_GEN_FLOAT,
+    /** A buffer of random bytes, in args[i].bytes and args[i].size. */
+    EZTEST_GEN_BYTES,
+    /** A NUL terminated string of printable ASCII characters, in args[i].str and args[i].size. */
+    EZTEST_GEN_STRING
+};
+
+/** Describes the values generated for one argument of a property test, see GEN_INT and its variants. */
+struct eztest_gen
+{
+    enum eztest_gen_kind kind;
+    /** The inclusive bounds of EZTEST_GEN_INT. */
+    int64_t min, max;
+    /** The inclusive bounds of EZTEST_GEN_FLOAT. */
+    double fmin, fmax;
+    /** The max size of EZTEST_GEN_BYTES and EZTEST_GEN_STRING, the terminator of a string excluded. */
+    size_t max_size;
+};
+
+/** A generated argument of a property test, only the members of the kind of its generator are set. */
+struct eztest_arg
+{
+    int64_t i;
+    double f;
+    const unsigned char *bytes;
+    const char *str;
+    /** The amount of bytes, or characters, of the bytes or the string. */
+    size_t size;
+};
+
+/** Generates integers in the inclusive range [lo, hi]. */
+#define GEN_INT(lo, hi) { .kind = EZTEST_GEN_INT, .min = (lo), .max = (hi) }
+
+/** Generates finite doubles in the inclusive range [lo, hi]. */
+#define GEN_FLOAT(lo, hi) { .kind = EZTEST_GEN_FLOAT, .fmin = (lo), .fmax = (hi) }
+
+/** Generates byte buffers of at most size bytes. */
+#define GEN_BYTES(size) { .kind = EZTEST_GEN_BYTES, .max_size = (size) }
+
+/** Generates strings of at most size printable ASCII characters. */
+#define GEN_STRING(size) { .kind = EZTEST_GEN_STRING, .max_size = (size) }
+
+void eztest_property(const struct eztest_gen *gens, size_t count, void (*property)(const struct eztest_arg *args),
+                     char *file, int line);
+/**
+ * Initializes a new property test. The test function is run with many generated arguments,
+ * given in the same order as the generators. When the asserts of the function fail for some
+ * arguments, they are shrunk to a minimal counterexample for which the asserts still fail.
+ * The failures of that counterexample are reported, together with the arguments and the seed
+ * that replays the run with the --seed option.
+ *
+ * @param suite The name of the test suite that this test belongs.
+ * @param name  The name of the test.
+ * @param ...   The generators of the arguments, like GEN_INT(0, 100).
+ * @note        The arguments are available in the test as @code const struct eztest_arg *args @endcode .
+ *              Memory from @see eztest_alloc(size); is released after each set of arguments.
+ */
+#define PROPERTY(suite, name, ...)\
+    static void EZTEST_PROPERTY_FN_NAME(suite, name)(const struct eztest_arg *args);\
+    static void EZTEST_RUN_FN_NAME(suite, name)(void)\
+    {\
+        static const struct eztest_gen gens[] = { __VA_ARGS__ };\
+        eztest_property(gens, sizeof(gens) / sizeof(gens[0]), EZTEST_PROPERTY_FN_NAME(suite, name),\
+                        __FILE__, __LINE__);\
+    }\
+    EZTEST_UNIT_TEST_STRUCT(suite, name);\
+    static void EZTEST_PROPERTY_FN_NAME(suite, name)(const struct eztest_arg *args)
+
+void eztest_fuzz(void (*target)(const uint8_t *data, size_t len), char *file, int line);
+/**
+ * Initializes a new fuzz test, followed by the parameters and the body of the fuzz target:
+ * @code FUZZ_TEST(suite, name)(const uint8_t *data, size_t len) { ... } @endcode
+ * In a normal run the target is run with each input of its corpus and crash directories, as
+ * one test. Run with --fuzz=suite.name, the target is fuzzed in the runner process: inputs are
+ * mutated from the corpus, and inputs reaching new coverage are added to the corpus directory.
+ * An input making an assert fail or crashing the process is written to the crash directory.
+ * The coverage is collected from code compiled with -fsanitize-coverage=trace-pc-guard, or
+ * -fsanitize-coverage=trace-pc with GCC.
+ *
+ * @param suite The name of the test suite that this test belongs.
+ * @param name  The name of the test.
+ * @note        The corpus is read from EZTEST_FUZZ_CORPUS_DIR/suite.name and the crashes from
+ *              EZTEST_FUZZ_CRASH_DIR/suite.name, relative to the working directory of the runner.
+ */
+#define FUZZ_TEST(suite, name)\
+    static void EZTEST_FUZZ_FN_NAME(suite, name)(const uint8_t *data, size_t len);\
+    static void EZTEST_RUN_FN_NAME(suite, name)(void)\
+    {\
+        eztest_fuzz(EZTEST_FUZZ_FN_NAME(suite, name), __FILE__, __LINE__);\
+    }\
+    EZTEST_UNIT_TEST_STRUCT(suite, name);\
+    static void EZTEST_FUZZ_FN_NAME(suite, name)
+
+/**
+ * A field of a row of a data test, pointing into the mapped data file, or into a copy when its
+ * doubled quotes were unescaped. It is not NUL terminated.
+ */
+struct eztest_field
+{
+    const char *data;
+    size_t size;
+};
+
+/** A row of a data test. */
+struct eztest_row
+{
+    /** The line of the row in the data file, starting at 1. */
+    size_t number;
+    /** The amount of fields. */
+    size_t count;
+    const struct eztest_field *fields;
+};
+
+/**
+ * Parses the given field as a decimal, hexadecimal (0x) or octal (0) integer.
+ *
+ * @return @code true @endcode if the whole field is a valid integer; otherwise @code false @endcode .
+ */
+bool eztest_field_int(const struct eztest_field *field, long long *value);
+/**
+ * Parses the given field as a floating point number.
+ *
+ * @return @code true @endcode if the whole field is a valid number; otherwise @code false @endcode .
+ */
+bool eztest_field_float(const struct eztest_field *field, double *value);
+
+void eztest_data(const char *path, void (*test)(const struct eztest_row *row), char *file, int line);
+/**
+ * Initializes a new data test, run with each row of the given CSV file. The file is memory mapped
+ * and read one row at a time, each field pointing into the mapping. Fields are separated by commas
+ * and may be enclosed in double quotes to hold commas, the quotes are left out of the field and
+ * doubled quotes inside it are replaced by one, in a copy of the field that lasts for the row.
+ * Empty lines and lines starting with # are skipped. The rows are run in order on the thread of
+ * the test, as the asserts of the rows report to the test.
+ *
+ * @param suite The name of the test suite that this test belongs.
+ * @param name  The name of the test.
+ * @param path  The path of the CSV file, relative to the working directory of the runner.
+ * @note        The row is available in the test as @code const struct eztest_row *row @endcode . A failure
+ *              reports the amount of failed rows and the line of the first.
+ */
+#define TEST_DATA(suite, name, path)\
+    static void EZTEST_DATA_FN_NAME(suite, name)(const struct eztest_row *row);\
+    static void EZTEST_RUN_FN_NAME(suite, name)(void)\
+    {\
+        eztest_data(path, EZTEST_DATA_FN_NAME(suite, name), __FILE__, __LINE__);\
+    }\
+    EZTEST_UNIT_TEST_STRUCT(suite, name);\
+    static void EZTEST_DATA_FN_NAME(suite, name)(const struct eztest_row *row)
+
+void eztest_data_records(const char *path, size_t size, void (*test)(const void *record), char *file, int line);
+/**
+ * Initializes a new data test, run with each record of the given binary file. The file is an array
+ * of records of the given type, which is memory mapped so that each record points into the mapping.
+ *
+ * @param suite The name of the test suite that this test belongs.
+ * @param name  The name of the test.
+ * @param path  The path of the binary file, relative to the working directory of the runner.
+ * @param type  The type of a record, in the byte order and layout of the file.
+ * @note        The record is available in the test as @code const type *record @endcode . A failure
+ *              reports the amount of failed records and the index of the first.
+ */
+#define TEST_DATA_RECORDS(suite, name, path, type)\
+    static void EZTEST_DATA_FN_NAME(suite, name)(const type *record);\
+    static void EZTEST_RECORD_FN_NAME(suite, name)(const void *record)\
+    {\
+        EZTEST_DATA_FN_NAME(suite, name)(record);\
+    }\
+    static void EZTEST_RUN_FN_NAME(suite, name)(void)\
+    {\
+        eztest_data_records(path, sizeof(type), EZTEST_RECORD_FN_NAME(suite, name), __FILE__, __LINE__);\
+    }\
+    EZTEST_UNIT_TEST_STRUCT(suite, name);\
+    static void EZTEST_DATA_FN_NAME(suite, name)(const type *record)
+
+/**
+ * Declares the context type of the fixture of the given suite, followed by the members of the struct.
+ *
+ * @param suite The name of the test suite that this fixture belongs.
+ * @note Each suite should only have one (1) fixture.
+ */
+#define FIXTURE(suite) struct EZTEST_FIXTURE_NAME(suite)
+
+/**
+ * Initializes the fixture setup function for the given suite. It fills the context, which is
+ * zero-initialized, before every test of the suite defined with TEST_F.
+ *
+ * @param suite The name of the test suite that this setup function belongs.
+ * @param ctx   The name of the pointer to the context.
+ */
+#define FIXTURE_SETUP(suite, ctx)\
+    static void EZTEST_FIXTURE_SETUP_FN_NAME(suite)(struct EZTEST_FIXTURE_NAME(suite) *ctx)
+
+/**
+ * Initializes the fixture teardown function for the given suite. It runs after every test of the
+ * suite defined with TEST_F. Memory from @see eztest_alloc(size); does not need to be freed here.
+ *
+ * @param suite The name of the test suite that this teardown function belongs.
+ * @param ctx   The name of the pointer to the context.
+ */
+#define FIXTURE_TEARDOWN(suite, ctx)\
+    static void EZTEST_FIXTURE_TEARDOWN_FN_NAME(suite)(struct EZTEST_FIXTURE_NAME(suite) *ctx)
+
+/**
+ * Initializes a new unit test using the fixture of the suite. The context lives on the stack of
+ * the test, so the fixture needs no global state. A FIXTURE, FIXTURE_SETUP and FIXTURE_TEARDOWN
+ * *must* be defined for the suite.
+ *
+ * @param suite The name of the test suite that this test belongs.
+ * @param name  The name of the test.
+ * @param ctx   The name of the pointer to the context in the test.
+ * @note        Suite and test-names must follow C naming rules.
+ *              Suite and test-name combination must be unique for the project.
+ */
+#define TEST_F(suite, name, ctx)\
+    static void EZTEST_FIXTURE_BODY_FN_NAME(suite, name)(struct EZTEST_FIXTURE_NAME(suite) *ctx);\
+    static void EZTEST_RUN_FN_NAME(suite, name)(void)\
+    {\
+        struct EZTEST_FIXTURE_NAME(suite) context = { 0 };\
+        EZTEST_FIXTURE_SETUP_FN_NAME(suite)(&context);\
+        EZTEST_FIXTURE_BODY_FN_NAME(suite, name)(&context);\
+        EZTEST_FIXTURE_TEARDOWN_FN_NAME(suite)(&context);\
+    }\
+    EZTEST_UNIT_TEST_STRUCT(suite, name);\
+    static void EZTEST_FIXTURE_BODY_FN_NAME(suite, name)(struct EZTEST_FIXTURE_NAME(suite) *ctx)
+
+/**
+ * Allocates memory that lives until the end of the current test. All memory allocated by a test
+ * is released at once after its teardown, so it is never freed by the test. The memory is not
+ * initialized and is suitably aligned for any type.
+ *
+ * @param size The amount of bytes to allocate.
+ * @return A pointer to the memory or @code NULL @endcode if out of memory.
+ * @note Memory allocated by the suite and environment setup functions is released after the
+ *       first test, use malloc or @see eztest_shared_alloc(size); there.
+ */
+void *eztest_alloc(size_t size);
+
+/** The amount of asserts evaluated by the test running on this thread. */
+extern _Thread_local uint64_t eztest_assert_count;
+
+/** Keeps the failure reporting out of the inlined asserts, failures are expected to be rare. */
+#define EZTEST_COLD __attribute__((cold, noinline))
+
+/**
+ * Defines an assert of one value that is inlined where it is used, so that a passing assert
+ * only costs the check. Failures are reported by the out of line function name##_failed.
+ *
+ * @param name   The name of the assert function.
+ * @param type   The type of the value.
+ * @param value  The name of the value.
+ * @param failed The expression that is true when the assert fails.
+ */
+#define EZTEST_INLINE_ASSERT1(name, type, value, failed)\
+    void name##_failed(type value, char *file, int line) EZTEST_COLD;\
+    static inline void name(type value, char *file, const int line)\
+    {\
+        eztest_assert_count++;\
+        if(failed) name##_failed(value, file, line);\
+    }
+
+/** @see EZTEST_INLINE_ASSERT1, for asserts of two values of the same type. */
+#define EZTEST_INLINE_ASSERT2(name, type, a, b, failed)\
+    void name##_failed(type a, type b, char *file, int line) EZTEST_COLD;\
+    static inline void name(type a, type b, char *file, const int line)\
+    {\
+        eztest_assert_count++;\
+        if(failed) name##_failed(a, b, file, line);\
+    }
+
+EZTEST_INLINE_ASSERT1(assert_is_null, const void *, value, value != NULL)
 #define ASSERT_IS_NULL(value) assert_is_null(value, __FILE__, __LINE__);
 
-void assert_is_not_null(const void *value, char *file, int line);
+EZTEST_INLINE_ASSERT1(assert_is_not_null, const void *, value, value == NULL)
 #define ASSERT_IS_NOT_NULL(value) assert_is_not_null(value, __FILE__, __LINE__);
 
-void assert_is_true(bool condition, char *file, int line);
+EZTEST_INLINE_ASSERT1(assert_is_true, bool, condition, condition != true)
 #define ASSERT_IS_TRUE(condition) assert_is_true(condition, __FILE__, __LINE__);
 
-void assert_is_false(bool condition, char *file, int line);
+EZTEST_INLINE_ASSERT1(assert_is_false, bool, condition, condition != false)
 #define ASSERT_IS_FALSE(condition) assert_is_false(condition, __FILE__, __LINE__);
 
-void assert_are_same(const void *expected, const void *actual, char *file, int line);
+EZTEST_INLINE_ASSERT2(assert_are_same, const void *, expected, actual, expected != actual)
 #define ASSERT_ARE_SAME(expected, actual) assert_are_same(expected, actual, __FILE__, __LINE__);
 
-void assert_are_not_same(const void *unexpected, const void *actual, char *file, int line);
+EZTEST_INLINE_ASSERT2(assert_are_not_same, const void *, unexpected, actual, unexpected == actual)
 #define ASSERT_ARE_NOT_SAME(unexpected, actual) assert_are_not_same(unexpected, actual, __FILE__, __LINE__);
 
 #ifdef NAN
@@ -134,12 +576,14 @@ void assert_is_nan(float value, char *file, int line);
 
 #endif
 
-void assert_are_equal_ch  (char            expected, char            actual, char *file, int line);
-void assert_are_equal_sch (signed char     expected, signed char     actual, char *file, int line);
-void assert_are_equal_uch (unsigned char   expected, unsigned char   actual, char *file, int line);
-void assert_are_equal_int (intmax_t        expected, intmax_t        actual, char *file, int line);
-void assert_are_equal_uint(uintmax_t       expected, uintmax_t       actual, char *file, int line);
-void assert_are_equal_dbl (long double     expected, long double     actual, char *file, int line);
+EZTEST_INLINE_ASSERT2(assert_are_equal_ch,   char,            expected, actual, expected != actual)
+EZTEST_INLINE_ASSERT2(assert_are_equal_sch,  signed char,     expected, actual, expected != actual)
+EZTEST_INLINE_ASSERT2(assert_are_equal_uch,  unsigned char,   expected, actual, expected != actual)
+EZTEST_INLINE_ASSERT2(assert_are_equal_int,  intmax_t,        expected, actual, expected != actual)
+EZTEST_INLINE_ASSERT2(assert_are_equal_uint, uintmax_t,       expected, actual, expected != actual)
+void assert_are_equal_flt (float           expected, float           actual, char *file, int line);
+void assert_are_equal_dbl (double          expected, double          actual, char *file, int line);
+void assert_are_equal_ldbl(long double     expected, long double     actual, char *file, int line);
 void assert_are_equal_str (const char    * expected, const char    * actual, char *file, int line);
 void assert_are_equal_wstr(const wchar_t * expected, const wchar_t * actual, char *file, int line);
 void assert_are_equal     (const void    * expected, const void    * actual, char *file, int line);
@@ -166,9 +610,9 @@ void assert_are_equal     (const void    * expected, const void    * actual, cha
              long long   : assert_are_equal_int,  \
     unsigned long long   : assert_are_equal_uint, \
                                                   \
-             float       : assert_are_equal_dbl,  \
+             float       : assert_are_equal_flt,  \
              double      : assert_are_equal_dbl,  \
-             long double : assert_are_equal_dbl,  \
+             long double : assert_are_equal_ldbl, \
                                                   \
              char *      : assert_are_equal_str,  \
     const    char *      : assert_are_equal_str,  \
@@ -185,12 +629,14 @@ void assert_are_equal     (const void    * expected, const void    * actual, cha
  */
 #define ASSERT_EQ(expected, actual) ASSERT_ARE_EQUAL(expected, actual)
 
-void assert_are_not_equal_ch  (char            unexpected, char            actual, char *file, int line);
-void assert_are_not_equal_sch (signed char     unexpected, signed char     actual, char *file, int line);
-void assert_are_not_equal_uch (unsigned char   unexpected, unsigned char   actual, char *file, int line);
-void assert_are_not_equal_int (intmax_t        unexpected, intmax_t        actual, char *file, int line);
-void assert_are_not_equal_uint(uintmax_t       unexpected, uintmax_t       actual, char *file, int line);
-void assert_are_not_equal_dbl (long double     unexpected, long double     actual, char *file, int line);
+EZTEST_INLINE_ASSERT2(assert_are_not_equal_ch,   char,            unexpected, actual, unexpected == actual)
+EZTEST_INLINE_ASSERT2(assert_are_not_equal_sch,  signed char,     unexpected, actual, unexpected == actual)
+EZTEST_INLINE_ASSERT2(assert_are_not_equal_uch,  unsigned char,   unexpected, actual, unexpected == actual)
+EZTEST_INLINE_ASSERT2(assert_are_not_equal_int,  intmax_t,        unexpected, actual, unexpected == actual)
+EZTEST_INLINE_ASSERT2(assert_are_not_equal_uint, uintmax_t,       unexpected, actual, unexpected == actual)
+void assert_are_not_equal_flt (float           unexpected, float           actual, char *file, int line);
+void assert_are_not_equal_dbl (double          unexpected, double          actual, char *file, int line);
+void assert_are_not_equal_ldbl(long double     unexpected, long double     actual, char *file, int line);
 void assert_are_not_equal_str (const char    * unexpected, const char    * actual, char *file, int line);
 void assert_are_not_equal_wstr(const wchar_t * unexpected, const wchar_t * actual, char *file, int line);
 void assert_are_not_equal     (const void    * unexpected, const void    * actual, char *file, int line);
@@ -199,9 +645,9 @@ void assert_are_not_equal     (const void    * unexpected, const void    * actua
  *
  * @param unexpected The first value to compare. This is the value that should not occur.
  * @param actual     The second value to compare. This is the value produced by the code under test.
- * @note The equality function for floating point numbers uses the epsilon macro from float.h
- *       in its equality test. It is therefore often better to use assert_are_equal_precision()
- *       and provide the application specific epsilon.
+ * @note Floats and doubles are equal when they are at most EZTEST_MAX_ULPS units in the last
+ *       place apart, long doubles when they are at most LDBL_EPSILON apart. Use
+ *       assert_are_not_equal_precision() to compare with an application specific tolerance.
  */
 #define ASSERT_ARE_NOT_EQUAL(unexpected, actual) _Generic((unexpected),\
              char        : assert_are_not_equal_ch,   \
@@ -220,9 +666,9 @@ void assert_are_not_equal     (const void    * unexpected, const void    * actua
              long long   : assert_are_not_equal_int,  \
     unsigned long long   : assert_are_not_equal_uint, \
                                                       \
-             float       : assert_are_not_equal_dbl,  \
+             float       : assert_are_not_equal_flt,  \
              double      : assert_are_not_equal_dbl,  \
-             long double : assert_are_not_equal_dbl,  \
+             long double : assert_are_not_equal_ldbl, \
                                                       \
              char *      : assert_are_not_equal_str,  \
     const    char *      : assert_are_not_equal_str,  \
@@ -275,6 +721,286 @@ void assert_not_equal_mem(const void *unexpected, const void *actual, size_t siz
  */
 #define ASSERT_NE_MEM(unexpected, actual, size) ASSERT_NOT_EQUAL_MEM(unexpected, actual, size)
 
+void assert_array_equal_int (const void *expected, const void *actual, size_t count, size_t width, char *file, int line);
+void assert_array_equal_uint(const void *expected, const void *actual, size_t count, size_t width, char *file, int line);
+/**
+ * Tests whether the two arrays of integers are equal, element by element.
+ * On failure the index of the first differing element, the elements around it and
+ * the total amount of differing elements are reported.
+ *
+ * @param expected A pointer to the first element of the expected array.
+ * @param actual   A pointer to the first element of the actual array, must have the same element type as expected.
+ * @param count    The amount of elements to compare.
+ */
+#define ASSERT_ARRAY_EQUAL(expected, actual, count) _Generic((expected)[0],\
+             char        : assert_array_equal_int,  \
+    signed   char        : assert_array_equal_int,  \
+    unsigned char        : assert_array_equal_uint, \
+                                                    \
+             short       : assert_array_equal_int,  \
+    unsigned short       : assert_array_equal_uint, \
+                                                    \
+             int         : assert_array_equal_int,  \
+    unsigned int         : assert_array_equal_uint, \
+                                                    \
+             long        : assert_array_equal_int,  \
+    unsigned long        : assert_array_equal_uint, \
+                                                    \
+             long long   : assert_array_equal_int,  \
+    unsigned long long   : assert_array_equal_uint)(expected, actual, count, sizeof((expected)[0]), __FILE__, __LINE__)
+
+/**
+ * @see ASSERT_ARRAY_EQUAL(expected, actual, count);
+ *
+ * @remarks This is a short-hand for ASSERT_ARRAY_EQUAL.
+ */
+#define ASSERT_ARRAY_EQ(expected, actual, count) ASSERT_ARRAY_EQUAL(expected, actual, count)
+
+/** How the tolerance of ASSERT_ARRAY_NEAR and its variants is applied. */
+enum eztest_tolerance
+{
+    /** The absolute difference of each pair of elements must be within the tolerance. */
+    EZTEST_TOLERANCE_ABS,
+    /** The difference relative to the larger magnitude of each pair of elements must be within the tolerance. */
+    EZTEST_TOLERANCE_REL,
+    /** The distance in units in the last place of each pair of elements must be within the tolerance. */
+    EZTEST_TOLERANCE_ULP
+};
+
+void assert_array_near_flt(const float  *expected, const float  *actual, size_t count, double tolerance,
+                           enum eztest_tolerance mode, char *file, int line);
+void assert_array_near_dbl(const double *expected, const double *actual, size_t count, double tolerance,
+                           enum eztest_tolerance mode, char *file, int line);
+/**
+ * Tests whether each element of the two floating point arrays is within the given tolerance
+ * of the corresponding element, using the given tolerance mode. Elements that are equal,
+ * including infinities, and pairs of NaN are always within the tolerance.
+ * On failure the index of the element with the largest error, the error and the amount of
+ * elements out of tolerance are reported.
+ *
+ * @param expected  A pointer to the first element of the expected float or double array.
+ * @param actual    A pointer to the first element of the actual array, must have the same element type as expected.
+ * @param count     The amount of elements to compare.
+ * @param tolerance The max allowed error.
+ * @param mode      How the error is measured, @see enum eztest_tolerance.
+ */
+#define EZTEST_ARRAY_NEAR(expected, actual, count, tolerance, mode) _Generic((expected)[0],\
+    float  : assert_array_near_flt, \
+    double : assert_array_near_dbl)(expected, actual, count, tolerance, mode, __FILE__, __LINE__)
+
+/**
+ * Tests whether the absolute difference of each pair of elements is within the given tolerance.
+ *
+ * @see EZTEST_ARRAY_NEAR(expected, actual, count, tolerance, mode);
+ */
+#define ASSERT_ARRAY_NEAR(expected, actual, count, tolerance)\
+    EZTEST_ARRAY_NEAR(expected, actual, count, tolerance, EZTEST_TOLERANCE_ABS)
+
+/**
+ * Tests whether the difference of each pair of elements, relative to the larger magnitude
+ * of the two, is within the given tolerance.
+ *
+ * @see EZTEST_ARRAY_NEAR(expected, actual, count, tolerance, mode);
+ */
+#define ASSERT_ARRAY_NEAR_REL(expected, actual, count, tolerance)\
+    EZTEST_ARRAY_NEAR(expected, actual, count, tolerance, EZTEST_TOLERANCE_REL)
+
+/**
+ * Tests whether each pair of elements is at most the given amount of units in the last place apart.
+ *
+ * @see EZTEST_ARRAY_NEAR(expected, actual, count, tolerance, mode);
+ */
+#define ASSERT_ARRAY_NEAR_ULP(expected, actual, count, ulps)\
+    EZTEST_ARRAY_NEAR(expected, actual, count, ulps, EZTEST_TOLERANCE_ULP)
+
+/** The condition that each element is tested for by ASSERT_ALL_IN_RANGE and its variants. */
+enum eztest_predicate
+{
+    /** The element is within the inclusive range [lo, hi]. */
+    EZTEST_ALL_IN_RANGE,
+    /** The element is equal to lo. */
+    EZTEST_ALL_EQUAL_VALUE,
+    /** The element is not less than the element before it. */
+    EZTEST_SORTED,
+    /** The element is neither infinite nor NaN. */
+    EZTEST_ALL_FINITE
+};
+
+void assert_all_int (const void *values, size_t count, size_t width, enum eztest_predicate predicate,
+                     intmax_t  lo, intmax_t  hi, char *file, int line);
+void assert_all_uint(const void *values, size_t count, size_t width, enum eztest_predicate predicate,
+                     uintmax_t lo, uintmax_t hi, char *file, int line);
+void assert_all_flt (const void *values, size_t count, size_t width, enum eztest_predicate predicate,
+                     double    lo, double    hi, char *file, int line);
+void assert_all_dbl (const void *values, size_t count, size_t width, enum eztest_predicate predicate,
+                     double    lo, double    hi, char *file, int line);
+/**
+ * Tests whether each element of the array satisfies the given predicate. A passing array is
+ * checked a vector at a time. On failure the amount of failing elements, the first one and
+ * the min and max of the array are reported in a single message.
+ *
+ * @param values    A pointer to the first element of an integer, float or double array.
+ * @param count     The amount of elements to test.
+ * @param predicate The condition to test, @see enum eztest_predicate.
+ * @param lo        The low bound, or the value, of the predicate. The bounds are converted to
+ *                  uintmax_t for unsigned arrays, like in any comparison with an unsigned value,
+ *                  and rounded to float for float arrays.
+ * @param hi        The high bound of the predicate.
+ */
+#define EZTEST_ALL(values, count, predicate, lo, hi) _Generic((values)[0],\
+             char        : assert_all_int,  \
+    signed   char        : assert_all_int,  \
+    unsigned char        : assert_all_uint, \
+                                            \
+             short       : assert_all_int,  \
+    unsigned short       : assert_all_uint, \
+                                            \
+             int         : assert_all_int,  \
+    unsigned int         : assert_all_uint, \
+                                            \
+             long        : assert_all_int,  \
+    unsigned long        : assert_all_uint, \
+                                            \
+             long long   : assert_all_int,  \
+    unsigned long long   : assert_all_uint, \
+                                            \
+             float       : assert_all_flt,  \
+             double      : assert_all_dbl)(values, count, sizeof((values)[0]), predicate, lo, hi, __FILE__, __LINE__)
+
+/**
+ * Tests whether each element of the array is within the inclusive range [lo, hi].
+ * NaN is never within the range.
+ *
+ * @see EZTEST_ALL(values, count, predicate, lo, hi);
+ */
+#define ASSERT_ALL_IN_RANGE(values, count, lo, hi) EZTEST_ALL(values, count, EZTEST_ALL_IN_RANGE, lo, hi)
+
+/**
+ * Tests whether each element of the array is equal to the given value.
+ *
+ * @see EZTEST_ALL(values, count, predicate, lo, hi);
+ */
+#define ASSERT_ALL_EQ_VALUE(values, count, value) EZTEST_ALL(values, count, EZTEST_ALL_EQUAL_VALUE, value, value)
+
+/**
+ * Tests whether the elements of the array are in ascending order, equal elements are allowed.
+ * An array containing NaN is not sorted.
+ *
+ * @see EZTEST_ALL(values, count, predicate, lo, hi);
+ */
+#define ASSERT_SORTED(values, count) EZTEST_ALL(values, count, EZTEST_SORTED, 0, 0)
+
+/**
+ * Tests whether each element of the float or double array is neither infinite nor NaN.
+ *
+ * @see EZTEST_ALL(values, count, predicate, lo, hi);
+ */
+#define ASSERT_ALL_FINITE(values, count) _Generic((values)[0],\
+    float  : assert_all_flt, \
+    double : assert_all_dbl)(values, count, sizeof((values)[0]), EZTEST_ALL_FINITE, 0, 0, __FILE__, __LINE__)
+
+void assert_text_equal(const char *expected, const char *actual, char *file, int line);
+/**
+ * Tests whether the two strings are equal. On failure the strings are compared line by line
+ * and the differing lines are reported as a unified diff, where the changed part of each
+ * changed line is marked.
+ *
+ * @param expected The expected text.
+ * @param actual   The actual text.
+ */
+#define ASSERT_TEXT_EQUAL(expected, actual) assert_text_equal(expected, actual, __FILE__, __LINE__)
+
+/**
+ * @see ASSERT_TEXT_EQUAL(expected, actual);
+ *
+ * @remarks This is a short-hand for ASSERT_TEXT_EQUAL.
+ */
+#define ASSERT_TEXT_EQ(expected, actual) ASSERT_TEXT_EQUAL(expected, actual)
+
+void assert_matches_golden(const void *actual, size_t size, const char *path, char *file, int line);
+/**
+ * Tests whether the given bytes are equal to the content of a golden file. The golden file is
+ * mapped into memory and compared in place, so no copy of it is made. When the runner is started
+ * with --update-golden the golden file is replaced by the given bytes instead.
+ *
+ * @param actual A pointer to the actual bytes.
+ * @param size   The amount of actual bytes.
+ * @param path   The path of the golden file.
+ */
+#define ASSERT_MATCHES_GOLDEN(actual, size, path)\
+    assert_matches_golden(actual, size, path, __FILE__, __LINE__)
+
+void assert_stream_equal_fd  (int    expected, int    actual, char *file, int line);
+void assert_stream_equal_file(FILE * expected, FILE * actual, char *file, int line);
+/**
+ * Tests whether the two streams are equal by reading them to the end in fixed size chunks,
+ * so the streams may be larger than the available memory. The streams are either both file
+ * descriptors or both FILE pointers. On failure the offset and the line of the first differing
+ * byte are reported.
+ *
+ * @param expected The expected stream.
+ * @param actual   The actual stream.
+ */
+#define ASSERT_STREAM_EQUAL(expected, actual)\
+    _Generic((expected),\
+    FILE *  : assert_stream_equal_file,\
+    default : assert_stream_equal_fd)(expected, actual, __FILE__, __LINE__)
+
+/**
+ * @see ASSERT_STREAM_EQUAL(expected, actual);
+ *
+ * @remarks This is a short-hand for ASSERT_STREAM_EQUAL.
+ */
+#define ASSERT_STREAM_EQ(expected, actual) ASSERT_STREAM_EQUAL(expected, actual)
+
+void assert_snapshot_hash(const void *actual, size_t size, bool blocks, char *file, int line);
+/**
+ * Tests whether the hash of the given bytes is equal to the hash recorded for this assert.
+ * The hashes are recorded in a snapshot file, keyed by the test and the ordinal of the snapshot
+ * assert within the test, when the runner is started with --update-snapshots.
+ *
+ * @param actual A pointer to the actual bytes.
+ * @param size   The amount of actual bytes.
+ */
+#define ASSERT_SNAPSHOT_HASH(actual, size) assert_snapshot_hash(actual, size, false, __FILE__, __LINE__)
+
+/**
+ * Like ASSERT_SNAPSHOT_HASH, but also records the hash of each block of EZTEST_SNAPSHOT_BLOCK_SIZE
+ * bytes, so that a failure reports which blocks changed.
+ *
+ * @see ASSERT_SNAPSHOT_HASH(actual, size);
+ */
+#define ASSERT_SNAPSHOT_HASH_BLOCKS(actual, size) assert_snapshot_hash(actual, size, true, __FILE__, __LINE__)
+
+void assert_same_elements(const void *expected, const void *actual, size_t count, size_t size,
+                          int (*cmp_fn)(const void *ptr1, const void *ptr2), size_t (*hash_fn)(const void *ptr),
+                          char *file, int line);
+/**
+ * Tests whether the two arrays contain the same elements, in any order. Elements are
+ * equal when all their bytes are equal. The arrays are compared in linear time by
+ * counting the elements in a hash table.
+ *
+ * @param expected A pointer to the first element of the expected array.
+ * @param actual   A pointer to the first element of the actual array.
+ * @param count    The amount of elements in each array.
+ * @param size     The size of each element in bytes.
+ */
+#define ASSERT_SAME_ELEMENTS(expected, actual, count, size)\
+    assert_same_elements(expected, actual, count, size, NULL, NULL, __FILE__, __LINE__)
+
+/**
+ * Tests whether the two arrays contain the same elements, in any order, using the passed
+ * comparator and hash function.
+ *
+ * @param cmp_fn  The comparator to use, it should return 0 (zero) if the elements are equal.
+ * @param hash_fn The hash function to use. Elements that are equal by the comparator must
+ *                have equal hashes. May be @code NULL @endcode if equal elements have equal bytes.
+ *
+ * @see ASSERT_SAME_ELEMENTS(expected, actual, count, size);
+ */
+#define ASSERT_SAME_ELEMENTS_CMP(expected, actual, count, size, cmp_fn, hash_fn)\
+    assert_same_elements(expected, actual, count, size, cmp_fn, hash_fn, __FILE__, __LINE__)
+
 void assert_greater_mem(const void *greater, const void *lesser, size_t size, char *file, int line);
 /**
  * Tests whether the first value is greater than the second value by comparing
@@ -576,12 +1302,14 @@ void assert_are_not_equal_precision(long double   unexpected,
  */
 #define ASSERT_NE_PRECISION(unexpected, actual, epsilon) ASSERT_ARE_NOT_EQUAL_PRECISION(unexpected, actual, epsilon)
 
-void assert_greater_ch  (char            greater, char            lesser, char *file, int line);
-void assert_greater_sch (signed char     greater, signed char     lesser, char *file, int line);
-void assert_greater_uch (unsigned char   greater, unsigned char   lesser, char *file, int line);
-void assert_greater_int (intmax_t        greater, intmax_t        lesser, char *file, int line);
-void assert_greater_uint(uintmax_t       greater, uintmax_t       lesser, char *file, int line);
-void assert_greater_dbl (long double     greater, long double     lesser, char *file, int line);
+EZTEST_INLINE_ASSERT2(assert_greater_ch,   char,            greater, lesser, greater <= lesser)
+EZTEST_INLINE_ASSERT2(assert_greater_sch,  signed char,     greater, lesser, greater <= lesser)
+EZTEST_INLINE_ASSERT2(assert_greater_uch,  unsigned char,   greater, lesser, greater <= lesser)
+EZTEST_INLINE_ASSERT2(assert_greater_int,  intmax_t,        greater, lesser, greater <= lesser)
+EZTEST_INLINE_ASSERT2(assert_greater_uint, uintmax_t,       greater, lesser, greater <= lesser)
+void assert_greater_flt (float           greater, float           lesser, char *file, int line);
+void assert_greater_dbl (double          greater, double          lesser, char *file, int line);
+void assert_greater_ldbl(long double     greater, long double     lesser, char *file, int line);
 void assert_greater_str (const char    * greater, const char    * lesser, char *file, int line);
 void assert_greater_wstr(const wchar_t * greater, const wchar_t * lesser, char *file, int line);
 void assert_greater     (const void    * greater, const void    * lesser, char *file, int line);
@@ -611,9 +1339,9 @@ void assert_greater     (const void    * greater, const void    * lesser, char *
              long long   : assert_greater_int,  \
     unsigned long long   : assert_greater_uint, \
                                                 \
-             float       : assert_greater_dbl,  \
+             float       : assert_greater_flt,  \
              double      : assert_greater_dbl,  \
-             long double : assert_greater_dbl,  \
+             long double : assert_greater_ldbl, \
                                                 \
              char *      : assert_greater_str,  \
     const    char *      : assert_greater_str,  \
@@ -659,12 +1387,14 @@ void assert_greater_precision(long double   greater,
 #define ASSERT_GT_PRECISION(greater, less, epsilon)\
     assert_greater_precision(greater, less, epsilon, __FILE__, __LINE__)
 
-void assert_greater_equal_ch  (char            ge, char            le, char *file, int line);
-void assert_greater_equal_sch (signed char     ge, signed char     le, char *file, int line);
-void assert_greater_equal_uch (unsigned char   ge, unsigned char   le, char *file, int line);
-void assert_greater_equal_int (intmax_t        ge, intmax_t        le, char *file, int line);
-void assert_greater_equal_uint(uintmax_t       ge, uintmax_t       le, char *file, int line);
-void assert_greater_equal_dbl (long double     ge, long double     le, char *file, int line);
+EZTEST_INLINE_ASSERT2(assert_greater_equal_ch,   char,            ge, le, ge < le)
+EZTEST_INLINE_ASSERT2(assert_greater_equal_sch,  signed char,     ge, le, ge < le)
+EZTEST_INLINE_ASSERT2(assert_greater_equal_uch,  unsigned char,   ge, le, ge < le)
+EZTEST_INLINE_ASSERT2(assert_greater_equal_int,  intmax_t,        ge, le, ge < le)
+EZTEST_INLINE_ASSERT2(assert_greater_equal_uint, uintmax_t,       ge, le, ge < le)
+void assert_greater_equal_flt (float           ge, float           le, char *file, int line);
+void assert_greater_equal_dbl (double          ge, double          le, char *file, int line);
+void assert_greater_equal_ldbl(long double     ge, long double     le, char *file, int line);
 void assert_greater_equal_str (const char    * ge, const char    * le, char *file, int line);
 void assert_greater_equal_wstr(const wchar_t * ge, const wchar_t * le, char *file, int line);
 void assert_greater_equal     (const void    * ge, const void    * le, char *file, int line);
@@ -694,9 +1424,9 @@ void assert_greater_equal     (const void    * ge, const void    * le, char *fil
              long long   : assert_greater_equal_int,  \
     unsigned long long   : assert_greater_equal_uint, \
                                                       \
-             float       : assert_greater_equal_dbl,  \
+             float       : assert_greater_equal_flt,  \
              double      : assert_greater_equal_dbl,  \
-             long double : assert_greater_equal_dbl,  \
+             long double : assert_greater_equal_ldbl, \
                                                       \
              char *      : assert_greater_equal_str,  \
     const    char *      : assert_greater_equal_str,  \
@@ -742,12 +1472,14 @@ void assert_greater_equal_precision(long double  ge,
 #define ASSERT_GE_PRECISION(ge, le, epsilon)\
     assert_greater_equal_precision(ge, le, epsilon, __FILE__, __LINE__)
 
-void assert_less_ch  (char           lesser, char           greater, char *file, int line);
-void assert_less_sch (signed char    lesser, signed char    greater, char *file, int line);
-void assert_less_uch (unsigned char  lesser, unsigned char  greater, char *file, int line);
-void assert_less_int (intmax_t       lesser, intmax_t       greater, char *file, int line);
-void assert_less_uint(uintmax_t      lesser, uintmax_t      greater, char *file, int line);
-void assert_less_dbl (long double    lesser, long double    greater, char *file, int line);
+EZTEST_INLINE_ASSERT2(assert_less_ch,   char,           lesser, greater, lesser >= greater)
+EZTEST_INLINE_ASSERT2(assert_less_sch,  signed char,    lesser, greater, lesser >= greater)
+EZTEST_INLINE_ASSERT2(assert_less_uch,  unsigned char,  lesser, greater, lesser >= greater)
+EZTEST_INLINE_ASSERT2(assert_less_int,  intmax_t,       lesser, greater, lesser >= greater)
+EZTEST_INLINE_ASSERT2(assert_less_uint, uintmax_t,      lesser, greater, lesser >= greater)
+void assert_less_flt (float          lesser, float          greater, char *file, int line);
+void assert_less_dbl (double         lesser, double         greater, char *file, int line);
+void assert_less_ldbl(long double    lesser, long double    greater, char *file, int line);
 void assert_less_str (const char    *lesser, const char    *greater, char *file, int line);
 void assert_less_wstr(const wchar_t *lesser, const wchar_t *greater, char *file, int line);
 void assert_less     (const void    *lesser, const void    *greater, char *file, int line);
@@ -777,9 +1509,9 @@ void assert_less     (const void    *lesser, const void    *greater, char *file,
              long long   : assert_less_int,  \
     unsigned long long   : assert_less_uint, \
                                              \
-             float       : assert_less_dbl,  \
+             float       : assert_less_flt,  \
              double      : assert_less_dbl,  \
-             long double : assert_less_dbl,  \
+             long double : assert_less_ldbl, \
                                              \
              char *      : assert_less_str,  \
     const    char *      : assert_less_str,  \
@@ -825,12 +1557,14 @@ void assert_less_precision(long double  lesser,
 #define ASSERT_LT_PRECISION(lesser, greater, epsilon)\
     assert_less_precision(lesser, greater, epsilon, __FILE__, __LINE__)
 
-void assert_less_equal_ch  (char           le, char           ge, char *file, int line);
-void assert_less_equal_sch (signed char    le, signed char    ge, char *file, int line);
-void assert_less_equal_uch (unsigned char  le, unsigned char  ge, char *file, int line);
-void assert_less_equal_int (intmax_t       le, intmax_t       ge, char *file, int line);
-void assert_less_equal_uint(uintmax_t      le, uintmax_t      ge, char *file, int line);
-void assert_less_equal_dbl (long double    le, long double    ge, char *file, int line);
+EZTEST_INLINE_ASSERT2(assert_less_equal_ch,   char,           le, ge, le > ge)
+EZTEST_INLINE_ASSERT2(assert_less_equal_sch,  signed char,    le, ge, le > ge)
+EZTEST_INLINE_ASSERT2(assert_less_equal_uch,  unsigned char,  le, ge, le > ge)
+EZTEST_INLINE_ASSERT2(assert_less_equal_int,  intmax_t,       le, ge, le > ge)
+EZTEST_INLINE_ASSERT2(assert_less_equal_uint, uintmax_t,      le, ge, le > ge)
+void assert_less_equal_flt (float          le, float          ge, char *file, int line);
+void assert_less_equal_dbl (double         le, double         ge, char *file, int line);
+void assert_less_equal_ldbl(long double    le, long double    ge, char *file, int line);
 void assert_less_equal_str (const char    *le, const char    *ge, char *file, int line);
 void assert_less_equal_wstr(const wchar_t *le, const wchar_t *ge, char *file, int line);
 void assert_less_equal     (const void    *le, const void    *ge, char *file, int line);
@@ -860,9 +1594,9 @@ void assert_less_equal     (const void    *le, const void    *ge, char *file, in
              long long   : assert_less_equal_int,  \
     unsigned long long   : assert_less_equal_uint, \
                                                    \
-             float       : assert_less_equal_dbl,  \
+             float       : assert_less_equal_flt,  \
              double      : assert_less_equal_dbl,  \
-             long double : assert_less_equal_dbl,  \
+             long double : assert_less_equal_ldbl, \
                                                    \
              char *      : assert_less_equal_str,  \
     const    char *      : assert_less_equal_str,  \
@@ -911,6 +1645,7 @@ void assert_less_equal_precision(long double  le,
 #ifdef TEST_RUNNER
 
 #include <stdio.h>
+#include <stddef.h>
 #include <string.h>
 #include <wchar.h>
 #include <math.h>
@@ -919,7 +1654,26 @@ void assert_less_equal_precision(long double  le,
 #include <assert.h>
 #include <time.h>
 #include <signal.h>
+#include <pthread.h>
 #include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <dirent.h>
+#include <locale.h>
+#include <stdio_ext.h>
+#include <stdatomic.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /** 
  *  This is the value returned when the runner encounters an error
@@ -947,6 +1701,29 @@ struct options
     bool skip;
     /** Handles segfault. */
     bool sigsegv;
+    /** The reporter used to produce output, @code NULL @endcode selects the console reporter. */
+    const struct reporter *reporter;
+    /** Path of the file to write the output to, @code NULL @endcode writes to stdout. */
+    char *output;
+    /** The max amount of failures to report for each test, 0 (zero) reports all failures. */
+    unsigned int max_failures;
+    /** When set to @code true @endcode passing tests that evaluated no asserts are flagged. */
+    bool flag_empty;
+    /** When set to @code true @endcode and stdout is a terminal, progress is shown on a single line. */
+    bool progress;
+    /** When set to @code true @endcode golden files are replaced by the actual value instead of compared. */
+    bool update_golden;
+    /** When set to @code true @endcode snapshot hashes are recorded instead of compared. */
+    bool update_snapshots;
+    /** The seed of the property tests, 0 (zero) picks a new seed for each run. */
+    uint64_t seed;
+    /**
+     * The amount of cases run by each property test, 0 (zero) runs @see EZTEST_PROPERTY_CASES.
+     * Also the amount of runs of a fuzzed test, 0 (zero) fuzzes until it is stopped.
+     */
+    unsigned int property_cases;
+    /** The fuzz test to fuzz, as suite.name, @code NULL @endcode runs the tests. */
+    const char *fuzz;
 };
 
 enum test_result
@@ -957,31 +1734,357 @@ enum test_result
     skip
 };
 
-/** Used to separate items in the skip list. */
-static const char *separator = ",";
+/** The type of the operands stored with a failure. */
+enum operand_type
+{
+    /** The failure message has no operands. */
+    operand_none,
+    /** Character operands, printed with %c. */
+    operand_char,
+    /** Signed integer operands. */
+    operand_int,
+    /** Unsigned integer operands. */
+    operand_uint,
+    /** Long double operands. */
+    operand_ldbl,
+    /** Float and double operands, each formatted twice: in decimal and in hex (%a). */
+    operand_dbl,
+    /** String operands, the strings are copied. */
+    operand_str,
+    /** Wide string operands, the strings are copied. */
+    operand_wstr,
+    /** Memory operands, the leading bytes are copied and printed in hex with %s. */
+    operand_mem,
+    /** A single array operand, see @see array_diff. */
+    operand_array,
+    /** A single array operand of bytes, printed as a hexdump after the message, see @see array_diff. */
+    operand_hexdump,
+    /** A single floating point array operand, see @see near_diff. */
+    operand_near,
+    /**
+     * An array operand of bytes, printed as a hexdump after the message, followed by an unsigned
+     * integer operand. The message is formatted with the index of the first differing byte and
+     * the integer, see @see array_diff.
+     */
+    operand_stream
+};
 
-/** A list of test suit names to skip separated by @see separator.*/
-static char *skip_list = NULL;
+/** The amount of elements printed before and after the first differing element of two arrays. */
+#define EZTEST_ARRAY_CONTEXT 2
 
-static const size_t ASSERT_BUFFER_SIZE = 512;
+/** The amount of bytes in each row of a hexdump. */
+#define EZTEST_HEXDUMP_WIDTH 16
 
-/** 
- * Holds the output of asserts for the current test.
- *
- * @remarks It should be "cleared" between each test.
- */
-static char *assert_buffer = NULL;
+/** The amount of rows of a hexdump, the first row is the one before the row of the first differing byte. */
+#define EZTEST_HEXDUMP_ROWS 4
 
-/** 
- * The current length of the assert buffer. 
- * 
- * @remarks This exists to remove some strlen calls.
- */
-static int assert_buffer_len = 0;
+#ifndef EZTEST_SNAPSHOT_FILE
+/** The file the snapshot hashes are recorded in, relative to the working directory of the runner. */
+#define EZTEST_SNAPSHOT_FILE "eztest.snapshots"
+#endif
 
-static int pass_count = 0;
+#ifndef EZTEST_SNAPSHOT_BLOCK_SIZE
+/** The amount of bytes in each block hashed by ASSERT_SNAPSHOT_HASH_BLOCKS. */
+#define EZTEST_SNAPSHOT_BLOCK_SIZE 65536
+#endif
+
+/** The amount of missing and of unexpected elements listed by a failed same elements assert. */
+#define EZTEST_SAME_ELEMENTS_LISTED 8
+
+#ifndef EZTEST_PROPERTY_CASES
+/** The amount of cases run by each property test, unless set with the --cases option. */
+#define EZTEST_PROPERTY_CASES 100
+#endif
+
+/** The amount of cases of a property test generated at a time. */
+#define EZTEST_PROPERTY_BATCH 64
+
+/** The max amount of times a property test is run while shrinking a counterexample. */
+#define EZTEST_PROPERTY_SHRINKS 2000
+
+#ifndef EZTEST_FUZZ_CORPUS_DIR
+/** The directory holding a directory of inputs for each fuzz test, relative to the working directory of the runner. */
+#define EZTEST_FUZZ_CORPUS_DIR "eztest.corpus"
+#endif
+
+#ifndef EZTEST_FUZZ_CRASH_DIR
+/** The directory holding a directory of crashing inputs for each fuzz test. */
+#define EZTEST_FUZZ_CRASH_DIR "eztest.crashes"
+#endif
+
+#ifndef EZTEST_FUZZ_MAX_LEN
+/** The max size of the inputs made while fuzzing. */
+#define EZTEST_FUZZ_MAX_LEN 4096
+#endif
+
+/** The amount of coverage counters, a power of two. */
+#define EZTEST_FUZZ_MAP_SIZE 65536
+
+/** The amount of bytes of a data file read before the pages already read are released. */
+#define EZTEST_DATA_CHUNK (8 * 1024 * 1024)
+
+/** How many elements ahead the same elements assert prefetches the hash table. */
+#define EZTEST_SAME_ELEMENTS_PREFETCH 16
+
+/** The amount of expected elements of each partition counted separately by the same elements assert. */
+#define EZTEST_SAME_ELEMENTS_PARTITION 16384
+
+/** The size in bytes of the widest elements compared by partitions by the same elements assert. */
+#define EZTEST_SAME_ELEMENTS_PARTITION_WIDTH 64
+
+/** The amount of changed block ranges listed by a failed snapshot assert. */
+#define EZTEST_SNAPSHOT_MAX_RANGES 8
+
+#ifndef EZTEST_STREAM_CHUNK_SIZE
+/** The amount of bytes read from each stream at a time by the stream asserts. */
+#define EZTEST_STREAM_CHUNK_SIZE 65536
+#endif
+
+/** Where two arrays differ, used as the operand of failed array and memory asserts. */
+struct array_diff
+{
+    /** The amount of compared elements. */
+    size_t count;
+    /** The amount of differing elements. */
+    size_t mismatches;
+    /** The index of the first differing element. */
+    size_t index;
+    /** The index of the first element in the context window. */
+    size_t start;
+    /** The amount of elements in the context window. */
+    size_t window;
+    /** The size of each element in bytes. */
+    size_t width;
+    /** Whether the elements are signed integers. */
+    bool is_signed;
+    /** The elements of the context window of each array. */
+    const unsigned char *elements[2];
+};
+
+/** The worst element of two floating point arrays, used as the operand of failed near asserts. */
+struct near_diff
+{
+    /** The amount of compared elements. */
+    size_t count;
+    /** The amount of elements out of tolerance. */
+    size_t far;
+    /** The index of the element with the largest error. */
+    size_t index;
+    /** The expected element at index. */
+    double expected;
+    /** The actual element at index. */
+    double actual;
+    /** The error of the element at index. */
+    double error;
+    /** The size of the elements, used to print them with enough digits to tell them apart. */
+    size_t width;
+};
+
+/** The value of a failed assert operand. */
+union operand
+{
+    intmax_t          i;
+    uintmax_t         u;
+    long double       ld;
+    double            d;
+    const char      * str;
+    const wchar_t   * wstr;
+    struct
+    {
+        const unsigned char *bytes;
+        size_t               size;
+    } mem;
+    const struct array_diff *array;
+    const struct near_diff  *near;
+};
+
+/**
+ * A failed assert. The failure message is not formatted until it is reported,
+ * see @see format_failure.
+ */
+struct failure
+{
+    /** The next failure of the same test, @code NULL @endcode if this is the last. */
+    struct failure *next;
+    /** The file containing the assert. */
+    const char *file;
+    /** The line of the assert. */
+    int line;
+    /** The amount of times the assert on this file and line failed in the test. */
+    size_t count;
+    /** Whether the failure is not reported due to the max failures option, only counted. */
+    bool suppressed;
+    /** The format string of the failure message. */
+    const char *fmt;
+    /** The type of the operands. */
+    enum operand_type type;
+    /** The operands of the first failure, formatted with @see fmt. */
+    union operand operands[2];
+};
+
+/** The outcome of a single test. */
+struct test_report
+{
+    /** The result of the test. */
+    enum test_result result;
+    /** The test execution time in ms. */
+    unsigned int time;
+    /**
+     * The reported failures in the order they first occurred, @code NULL @endcode if none.
+     * Repeated failures of the same assert are collapsed into one failure.
+     */
+    const struct failure *failures;
+    /** The amount of failures that were not reported due to the max failures option. */
+    size_t suppressed;
+    /** The amount of asserts evaluated by the test. */
+    uint64_t asserts;
+};
+
+/** The accumulated outcome of the tests in a suite. */
+struct suite_report
+{
+    /** The name of the suite. */
+    const char *name;
+    /** The amount of tests run in the suite, skipped tests excluded. */
+    int tests;
+    /** The amount of asserts evaluated by the tests in the suite. */
+    uint64_t asserts;
+    /** The total execution time of the tests in the suite in ms. */
+    unsigned int time;
+};
+
+/** The outcome of a test run. */
+struct run_report
+{
+    /** The amount of tests that passed. */
+    int pass;
+    /** The amount of tests that were skipped. */
+    int skip;
+    /** The amount of tests that failed. */
+    int fail;
+    /** The amount of passing tests that evaluated no asserts. */
+    int empty;
+    /** The total execution time in ms. */
+    unsigned int time;
+    /** The total amount of asserts evaluated. */
+    uint64_t asserts;
+    /** The amount of asserts evaluated per second while running tests. */
+    double assert_rate;
+    /** The suites in the order their first test was run. */
+    const struct suite_report *suites;
+    /** The amount of suites. */
+    size_t suite_count;
+};
+
+/**
+ * A reporter receives the test events generated by the runner and is
+ * responsible for producing all of the runner output.
+ */
+struct reporter
+{
+    /** The name used to select the reporter from the command line. */
+    const char *name;
+
+    /**
+     * Called once after test discovery, before any test is run.
+     *
+     * @param count The amount of discovered tests.
+     */
+    void (*run_start)(int count);
+
+    /**
+     * Called before a test is run or skipped.
+     *
+     * @param test The test about to run.
+     */
+    void (*test_start)(const struct unit_test *test);
+
+    /**
+     * Called for each reported failure of a test when the test has finished, right before
+     * @see test_end. Repeated failures of the same assert are collapsed into one failure
+     * holding the amount of times it failed.
+     *
+     * @param test    The test that the assert belongs to.
+     * @param failure The failure.
+     */
+    void (*assert_fail)(const struct unit_test *test, const struct failure *failure);
+
+    /**
+     * Called when a test has finished.
+     *
+     * @param test   The finished test.
+     * @param report The outcome of the test, including all reported failures.
+     */
+    void (*test_end)(const struct unit_test *test, const struct test_report *report);
+
+    /**
+     * Called once all tests have finished.
+     *
+     * @param report The outcome of the test run.
+     */
+    void (*run_end)(const struct run_report *report);
+};
+
+/** Used to separate items in the skip list. */
+static const char *separator = ",";
+
+/** A list of test suit names to skip separated by @see separator.*/
+static char *skip_list = NULL;
+
+/** The failures of the current test. */
+static struct failure *failures = NULL;
+
+/** Where to link the next failure of the current test. */
+static struct failure **failures_tail = &failures;
+
+/** The amount of distinct failures registered for the current test. */
+static size_t failure_count = 0;
+
+/** The amount of distinct asserts of the current test that were not reported due to the max failures option. */
+static size_t suppressed_count = 0;
+
+/** A slot of the failure table, it only holds a failure of the current test if its generation is current. */
+struct failure_slot
+{
+    struct failure *failure;
+    size_t generation;
+};
+
+/**
+ * Maps the file and line of an assert to its failure in the current test, reported or suppressed.
+ * Open addressing with linear probing, the capacity is a power of two.
+ */
+static struct
+{
+    struct failure_slot *slots;
+    size_t cap;
+    /** The amount of failures held by the table. */
+    size_t count;
+    /** The generation of the current test, increased to empty the table in O(1). */
+    size_t generation;
+} failure_table = { NULL, 0, 0, 1 };
+
+static int pass_count = 0;
 static int fail_count = 0;
 static int skip_count = 0;
+static int empty_count = 0;
+
+/**
+ * The amount of asserts evaluated by the current test. Thread local so that counting
+ * stays a plain increment, only asserts evaluated on the thread running the test are counted.
+ */
+_Thread_local uint64_t eztest_assert_count = 0;
+
+/** The total amount of asserts evaluated. */
+static uint64_t total_assert_count = 0;
+
+/** Accumulated results for each suite, in the order the suites were first run. */
+static struct
+{
+    struct suite_report *suites;
+    size_t count;
+    size_t cap;
+} suite_reports = { NULL, 0, 0 };
 
 /** The current test. */
 static struct unit_test *current = NULL;
@@ -989,9 +2092,24 @@ static struct unit_test *current = NULL;
 /** Application options */
 static struct options *options = NULL;
 
+/** The reporter receiving the test events. */
+static const struct reporter *reporter = NULL;
+
+/** The file descriptor all reporters write to. */
+static int output_fd = STDOUT_FILENO;
+
 /** The result of the current/ latest test. */
 static enum test_result result = undefined;
 
+/** When set to @code true @endcode failing asserts only set @see property_failed. */
+static bool property_probe = false;
+
+/** Whether an assert failed while @see property_probe was set. */
+static bool property_failed = false;
+
+/** The seed of the property tests in this run. */
+static uint64_t property_seed = 0;
+
 /** Create base/ reference test. */
 TEST(eztest_base_suite, eztest_base_test){}
 
@@ -1004,9 +2122,9 @@ TEST(eztest_base_suite, eztest_base_test){}
  * @param path The path of which to extract the file name.
  * @return A char pointer to the first char in the file name.
  */
-static const char *extract_file_name(char *path)
+static const char *extract_file_name(const char *path)
 {
-    char *tmp = strrchr(path, '/');
+    const char *tmp = strrchr(path, '/');
     if(tmp == NULL)
     {
         return path;
@@ -1034,1049 +2152,7431 @@ static const char *color(const char *color)
     return color;
 }
 
-static void register_file_marker(char *file, const int line)
-{
-    assert_buffer_len += snprintf(
-            assert_buffer + assert_buffer_len,
-            ASSERT_BUFFER_SIZE - assert_buffer_len,
-            "\n%s└──%s See file %s line %d %s", COLOR_NONE, color(COLOR_YELLOW), extract_file_name(file), line, COLOR_NONE);
-}
+//region arena
 
-/** Prints an overall report of the test results. */
-static void print_report(void)
+/** The minimum size of each block allocated by an arena. */
+#define EZTEST_ARENA_BLOCK_SIZE (16 * 1024)
+
+/** A block of memory owned by an arena. */
+struct arena_block
 {
-    if(options->quiet) return;
+    /** The next block, @code NULL @endcode if this is the last block. */
+    struct arena_block *next;
+    /** The amount of usable bytes in the block. */
+    size_t size;
+    /** The amount of bytes handed out from the block. */
+    size_t used;
+    /** The memory handed out by the arena. */
+    max_align_t data[];
+};
 
-    printf("-----------------------------------\n"
-           "|  "
-           "%sPASSED"  COLOR_NONE "  |  "
-           "%sSKIPPED" COLOR_NONE "  |  "
-           "%sFAILED"  COLOR_NONE "  |\n"
-           "-----------------------------------\n"
-           "| "
-           " %s%-7d" COLOR_NONE " | "
-           " %s%-8d" COLOR_NONE " | "
-           " %s%-7d" COLOR_NONE " |\n"
-           "-----------------------------------\n\n",
-           color(COLOR_GREEN) ,
-           color(COLOR_YELLOW),
-           color(COLOR_RED)   ,
-           color(COLOR_GREEN) , pass_count,
-           color(COLOR_YELLOW), skip_count,
-           color(COLOR_RED)   , fail_count);
-}
+/**
+ * A bump allocator. Memory is handed out from a list of blocks that is kept
+ * when the arena is reset, so that an arena that has grown large enough
+ * stops allocating.
+ */
+struct arena
+{
+    /** The first block, @code NULL @endcode until the first allocation. */
+    struct arena_block *head;
+    /** The block currently allocated from. */
+    struct arena_block *current;
+};
 
 /**
- * Prints the test result output if and only if the quiet option has not been set.
+ * Allocates memory from the given arena. The memory is suitably aligned for any type.
  *
- * @param test The unit test to print result for.
- * @param time The test execution time in ms.
- * @param resstr The string representing the result (Eg. PASS, FAIL etc)
- * @param c The requested color of the output result string.
+ * @param arena The arena to allocate from (not NULL).
+ * @param size  The amount of bytes to allocate.
+ * @return A pointer to the allocated memory or @code NULL @endcode if out of memory.
  */
-static void print_result(const struct unit_test *test,
-                         const unsigned int time,
-                         const char *restrict resstr,
-                         const char *restrict c)
+static void *arena_alloc(struct arena *arena, size_t size)
 {
-    if(options->quiet) return;
-    
-    printf("|%s %s %s] %s : %s " COLOR_NONE, 
-            // Print result with the given color.
-            color(c), resstr, COLOR_NONE, 
-            // Print test suite and name
-            test->test_suite, test->test_name);
+    assert(arena != NULL);
 
-    if(options->timer)
+    const size_t align = sizeof(max_align_t);
+    // Neither the rounding below nor the block header may wrap around.
+    if(size > SIZE_MAX - align - sizeof(struct arena_block))
     {
-        printf("(%dms)\n", time);
+        return NULL;
     }
-    else
+    size = (size + align - 1) & ~(align - 1);
+
+    struct arena_block *block = arena->current;
+    while(block != NULL)
+    {
+        if(block->size - block->used >= size)
+        {
+            void *ptr = (char *)block->data + block->used;
+            block->used += size;
+            return ptr;
+        }
+        if(block->next == NULL)
+        {
+            break;
+        }
+        // Move on to the next block kept from before the latest reset.
+        block = block->next;
+        block->used = 0;
+        arena->current = block;
+    }
+
+    const size_t block_size = size > EZTEST_ARENA_BLOCK_SIZE ? size : EZTEST_ARENA_BLOCK_SIZE;
+    struct arena_block *new_block = malloc(sizeof(struct arena_block) + block_size);
+    if(new_block == NULL)
     {
-        printf("\n");
+        return NULL;
     }
-    
-    if(assert_buffer_len > 0)
+    new_block->next = NULL;
+    new_block->size = block_size;
+    new_block->used = size;
+
+    if(block == NULL)
+    {
+        arena->head = new_block;
+    }
+    else
     {
-        puts(assert_buffer);
+        block->next = new_block;
     }
-    printf("\n");
-    fflush(stdout);
+    arena->current = new_block;
+    return new_block->data;
 }
 
-static void print_failed(const struct unit_test *test, const unsigned int time)
+/**
+ * Releases all memory handed out by the arena in O(1), the blocks are kept for reuse.
+ *
+ * @param arena The arena to reset (not NULL).
+ */
+static void arena_reset(struct arena *arena)
 {
-    print_result(test, time, "FAILED", COLOR_RED);
+    assert(arena != NULL);
+
+    arena->current = arena->head;
+    if(arena->head != NULL)
+    {
+        arena->head->used = 0;
+    }
 }
 
-static void print_passed(const struct unit_test *test, const unsigned int time)
+/**
+ * Frees all blocks owned by the arena.
+ *
+ * @param arena The arena to free (not NULL).
+ */
+static void arena_free(struct arena *arena)
 {
-    print_result(test, time, "PASSED", COLOR_GREEN);
+    assert(arena != NULL);
+
+    struct arena_block *block = arena->head;
+    while(block != NULL)
+    {
+        struct arena_block *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->head = NULL;
+    arena->current = NULL;
 }
 
-static void print_skipped(const struct unit_test *test, const unsigned int time)
+/** Holds the failures of the current test, reset between tests. */
+static struct arena failure_arena = { NULL, NULL };
+
+/** Holds the instances of the parameterized tests and their names, for the whole run. */
+static struct arena plan_arena = { NULL, NULL };
+
+/** The memory handed out by eztest_alloc, reset after each test. */
+static struct arena test_arena = { NULL, NULL };
+
+void *eztest_alloc(const size_t size)
 {
-    print_result(test, time, "SKIPPED", COLOR_YELLOW);
+    return arena_alloc(&test_arena, size);
 }
 
+//endregion arena
+
+//region output
+
+/** The size of the buffer holding output that has not yet been written. */
+#define EZTEST_OUTPUT_BUFFER_SIZE (64 * 1024)
+
+/** The amount of test results that may be buffered before the output is flushed. */
+#ifndef EZTEST_FLUSH_RESULTS
+#define EZTEST_FLUSH_RESULTS 256
+#endif
+
+/** The max time in ms that a test result may be buffered before the output is flushed. */
+#ifndef EZTEST_FLUSH_INTERVAL
+#define EZTEST_FLUSH_INTERVAL 100
+#endif
+
+/** Holds output that has not yet been written to @see output_fd. */
+static char output_buffer[EZTEST_OUTPUT_BUFFER_SIZE];
+
+/** The amount of bytes currently held in the output buffer. */
+static size_t output_len = 0;
+
+/** The amount of test results written since the latest flush. */
+static unsigned int output_results = 0;
+
+/** The time of the latest flush in ms. */
+static uint64_t output_flush_time = 0;
+
 /**
- * Store the n first bytes at the memory location pointed to by the given pointer in hex.
- * 
- * @param buffer Location of which the bytes will be written to.
- * @param ptr    Pointer to the memory location of which to start.
- * @param n      The amount of bytes to print.
+ * Guards the output buffer. The runner holds it except while a test runs, when the
+ * flush thread may flush the results buffered before the test.
+ */
+static pthread_mutex_t output_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/** Wakes the flush thread when results are left buffered or the output is closed. */
+static pthread_cond_t output_buffered;
+
+static pthread_t output_thread;
+
+/** Whether the flush thread was started. */
+static bool output_thread_started = false;
+
+/** Whether the runner holds @see output_lock. */
+static bool output_held = false;
+
+/** Set to stop the flush thread. */
+static bool output_stopping = false;
+
+/**
+ * Set by a signal handler that takes the output over from the flush thread. A handler cannot
+ * take @see output_lock, so the flush thread stops flushing once this is set instead.
+ */
+static atomic_bool output_signaled = false;
+
+/** Set while the flush thread decides whether to flush and while it flushes. */
+static atomic_bool output_flushing = false;
+
+/**
+ * Gets the current time in ms from a monotonic clock.
+ *
+ * @return The current time in ms.
  */
-static void register_bytes(char *buffer, const void *ptr, size_t n)
+static uint64_t monotonic_ms(void)
 {
-    const unsigned char *bytes = (const unsigned char *)ptr;
-    for (; n > 0; --n, ++bytes)
-    {
-        snprintf(buffer + strlen(buffer), 128 - strlen(buffer), "%x", *bytes);
-    }
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
 }
 
 /**
- * Registers the current test as a failure and prints the given failure message.
+ * Writes all the given bytes to the given file descriptor.
  *
- * @param msg The failure message to print.
- * @param ... Message arguments.
+ * @return On success @code EZTEST_RESULT_OK @endcode; otherwise @code EZTEST_RESULT_ERR @endcode.
+ * @remarks Only uses write(2) so that it is safe to call from a signal handler.
  */
-static void register_fail(char *file, const int line, const char *msg, ...)
+static int write_all(const int fd, const void *data, size_t len)
 {
-    result = fail;
-    
-    if(options->quiet)
+    const char *bytes = data;
+    while(len > 0)
     {
-        return;
+        const ssize_t n = write(fd, bytes, len);
+        if(n < 0)
+        {
+            if(errno == EINTR) continue;
+            return EZTEST_RESULT_ERR;
+        }
+        bytes += n;
+        len   -= (size_t)n;
     }
-    
-    assert_buffer_len += snprintf(assert_buffer + assert_buffer_len, ASSERT_BUFFER_SIZE - assert_buffer_len, "%s├── %s", COLOR_NONE, color(COLOR_YELLOW));
-    va_list va;
-    va_start(va, msg);
-    assert_buffer_len += vsnprintf(assert_buffer + assert_buffer_len, ASSERT_BUFFER_SIZE - assert_buffer_len, msg, va);
-    va_end(va);
-    register_file_marker(file, line);
+    return EZTEST_RESULT_OK;
 }
 
-//endregion printers
+/**
+ * Writes all the given bytes to the output file descriptor.
+ *
+ * @remarks Only uses write(2) so that it is safe to call from a signal handler.
+ */
+static void output_write_fd(const char *data, const size_t len)
+{
+    write_all(output_fd, data, len);
+}
 
-//region asserts
+/**
+ * Writes the buffered output.
+ *
+ * @remarks This is safe to call from a signal handler.
+ */
+static void output_flush(void)
+{
+    output_write_fd(output_buffer, output_len);
+    output_len = 0;
+    output_results = 0;
+}
 
-void assert_is_null(const void *value, char *file, const int line)
+/**
+ * Appends the given bytes to the output buffer, flushing the buffer when it is full.
+ *
+ * @param data The bytes to write.
+ * @param len  The amount of bytes to write.
+ */
+static void output_write(const void *data, const size_t len)
 {
-    if (value != NULL)
+    if(output_len + len > EZTEST_OUTPUT_BUFFER_SIZE)
     {
-        register_fail(file, line, "Assert is null failed: value is not null.");
+        output_flush();
+        if(len > EZTEST_OUTPUT_BUFFER_SIZE)
+        {
+            output_write_fd(data, len);
+            return;
+        }
     }
+    memcpy(output_buffer + output_len, data, len);
+    output_len += len;
 }
 
-void assert_is_not_null(const void *value, char *file, const int line)
+/**
+ * Formats the given message directly into the output buffer.
+ *
+ * @param fmt The format string.
+ * @param ... Format arguments.
+ */
+static void output_printf(const char *fmt, ...)
 {
-    if (value == NULL)
+    va_list va;
+    va_start(va, fmt);
+    int n = vsnprintf(output_buffer + output_len, EZTEST_OUTPUT_BUFFER_SIZE - output_len, fmt, va);
+    va_end(va);
+
+    if(n < 0 || (size_t)n < EZTEST_OUTPUT_BUFFER_SIZE - output_len)
     {
-        register_fail(file, line, "Assert is not null failed: value is null.");
+        output_len += n < 0 ? 0 : (size_t)n;
+        return;
     }
-}
 
-void assert_is_true(const bool condition, char *file, const int line)
-{
-    if(condition != true)
+    // Did not fit, make room and format again.
+    output_flush();
+    if((size_t)n < EZTEST_OUTPUT_BUFFER_SIZE)
     {
-        register_fail(file, line, "Assert is true failed.");
+        va_start(va, fmt);
+        output_len = (size_t)vsnprintf(output_buffer, EZTEST_OUTPUT_BUFFER_SIZE, fmt, va);
+        va_end(va);
+        return;
     }
+
+    char *tmp = malloc((size_t)n + 1);
+    if(tmp == NULL) return;
+    va_start(va, fmt);
+    vsnprintf(tmp, (size_t)n + 1, fmt, va);
+    va_end(va);
+    output_write_fd(tmp, (size_t)n);
+    free(tmp);
 }
 
-void assert_is_false(const bool condition, char *file, const int line)
+/**
+ * Marks the end of a test result. The output is flushed once @see EZTEST_FLUSH_RESULTS
+ * results have been buffered or when @see EZTEST_FLUSH_INTERVAL ms has passed since
+ * the latest flush, whichever comes first. This keeps the amount of write calls low
+ * while the progress still appears live.
+ */
+static void output_result_done(void)
 {
-    if(condition != false)
+    output_results++;
+
+    const uint64_t now = monotonic_ms();
+    if(output_results >= EZTEST_FLUSH_RESULTS || now - output_flush_time >= EZTEST_FLUSH_INTERVAL)
+    {
+        output_flush();
+        output_flush_time = now;
+    }
+    else if(output_thread_started)
     {
-        register_fail(file, line, "Assert is false failed.");
+        pthread_cond_signal(&output_buffered);
     }
 }
 
-void assert_are_same(const void *expected, const void *actual, char *file, const int line)
+/**
+ * Flushes results that have been buffered for @see EZTEST_FLUSH_INTERVAL ms while a test
+ * runs, so that buffered results do not wait for a long test to finish.
+ */
+static void *output_flusher(void *arg)
 {
-    if(expected != actual)
+    (void)arg;
+    pthread_mutex_lock(&output_lock);
+    while(!output_stopping)
     {
-        register_fail(file, line, "Assert are same failed: different memory location.");
+        const uint64_t now = monotonic_ms();
+        if(output_len == 0)
+        {
+            pthread_cond_wait(&output_buffered, &output_lock);
+        }
+        else if(now - output_flush_time >= EZTEST_FLUSH_INTERVAL)
+        {
+            atomic_store(&output_flushing, true);
+            const bool signaled = atomic_load(&output_signaled);
+            if(!signaled)
+            {
+                output_flush();
+                output_flush_time = now;
+            }
+            atomic_store(&output_flushing, false);
+            if(signaled)
+            {
+                break;
+            }
+        }
+        else
+        {
+            const uint64_t due = output_flush_time + EZTEST_FLUSH_INTERVAL;
+            const struct timespec deadline = { (time_t)(due / 1000), (long)(due % 1000) * 1000000 };
+            pthread_cond_timedwait(&output_buffered, &output_lock, &deadline);
+        }
     }
+    pthread_mutex_unlock(&output_lock);
+    return NULL;
 }
 
-void assert_are_not_same(const void *unexpected, const void *actual, char *file, const int line)
+/**
+ * Writes what the test printed to stdout before its result is buffered. The output buffer
+ * is flushed first, so that the output of the test stays between the results before it and
+ * its own result when stdout is a pipe or a file. Does nothing when the test printed nothing.
+ */
+static void output_sync_stdout(void)
 {
-    if(unexpected == actual)
+    if(output_fd == STDOUT_FILENO && __fpending(stdout) > 0)
     {
-        register_fail(file, line, "Assert are not same failed: same memory location.");
+        output_flush();
+        fflush(stdout);
     }
 }
 
-#ifdef NAN
-
-void assert_is_nan(const float value, char *file, const int line)
+/** Lets the flush thread flush the buffered output while a test runs. */
+static void output_release(void)
 {
-    if(!isnan(value))
+    if(output_thread_started)
     {
-        register_fail(file, line, "Assert is NaN failed.");
+        output_held = false;
+        pthread_mutex_unlock(&output_lock);
     }
 }
 
-#endif
-
-void mem_test_failed(const void *ptr1, const void *ptr2, const size_t  size, char *file, 
-                     const int   line, const char *msg1, const char   *msg2)
+/** Takes the output back from the flush thread once a test has run. */
+static void output_acquire(void)
 {
-    result = fail;
-        
-    if(options->quiet)
+    if(output_thread_started)
     {
-        return;
-    }   
-
-    char buf[128];
-    buf[0] = '\0';
-
-    snprintf(buf, 128, "%s '0x", msg1);
-    register_bytes(buf, ptr1, (size > EZTEST_MAX_PRINTABLE_LEN ? EZTEST_MAX_PRINTABLE_LEN : size));
-    snprintf(buf + strlen(buf), 128 - strlen(buf), "%s'%s '0x", (size > EZTEST_MAX_PRINTABLE_LEN ? "..." : ""), msg2);
-    register_bytes(buf, ptr2, (size > EZTEST_MAX_PRINTABLE_LEN ? EZTEST_MAX_PRINTABLE_LEN : size));
-    snprintf(buf + strlen(buf), 128 - strlen(buf), "%s", (size > EZTEST_MAX_PRINTABLE_LEN ? "...'." : "'."));
-
-    register_fail(file, line, buf);
+        pthread_mutex_lock(&output_lock);
+        output_held = true;
+    }
 }
 
-void assert_equal_mem(const void *expected, const void *actual, const size_t size, char *file, const int line)
+/** Writes the buffered output at exit, also when a test exits while the flush thread may be flushing. */
+static void output_exit(void)
 {
-    if((expected == NULL && actual != NULL) ||
-       (expected != NULL && actual == NULL) ||
-       (expected != NULL && memcmp(expected, actual, size) != 0))
+    const bool lock = output_thread_started && !output_held;
+    if(lock)
     {
-        mem_test_failed(expected, actual, size, file, line, "Assert are equal failed: expected", ", but got");
+        pthread_mutex_lock(&output_lock);
+    }
+    output_flush();
+    if(lock)
+    {
+        pthread_mutex_unlock(&output_lock);
     }
 }
 
-void assert_not_equal_mem(const void *unexpected, const void *actual, const size_t size, char *file, const int line)
+/**
+ * Takes the output over from the flush thread in a signal handler: stops the flush thread
+ * from flushing and waits for a flush in progress to finish.
+ *
+ * @remarks Only uses lock-free atomics and nanosleep(2) so that it is safe to call from a signal handler.
+ */
+static void output_take_over(void)
 {
-    if((unexpected == NULL && actual == NULL) ||
-       (unexpected != NULL && actual != NULL && memcmp(unexpected, actual, size) == 0))
+    atomic_store(&output_signaled, true);
+    while(atomic_load(&output_flushing))
     {
-        mem_test_failed(unexpected, actual, size, file, line, "Assert not equal failed:", "is equal to");
+        const struct timespec pause = { 0, 100000 };
+        nanosleep(&pause, NULL);
     }
 }
 
+/** The signals that terminate the process and should cause the output to be flushed. */
+static const int output_signals[] = { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT, SIGINT, SIGTERM };
 
+/** The handlers of @see output_signals before the output was opened, in the same order. */
+static struct sigaction output_old_actions[sizeof(output_signals) / sizeof(output_signals[0])];
+
+/** Restores the handler of the given signal from before the output was opened and raises the signal again for it. */
+static void output_chain_signal(const int signum)
+{
+    for(size_t i = 0; i < sizeof(output_signals) / sizeof(output_signals[0]); i++)
+    {
+        if(output_signals[i] == signum)
+        {
+            sigaction(signum, &output_old_actions[i], NULL);
+        }
+    }
+    raise(signum);
+}
+
+/** Flushes the buffered output before the given signal is passed on to the handler from before the output was opened. */
+static void output_on_signal(int signum)
+{
+    output_take_over();
+    output_flush();
+    output_chain_signal(signum);
+}
+
+/**
+ * Opens the output and makes sure that the buffered output is written on exit or when the
+ * process is terminated by a signal.
+ *
+ * @return On success @code EZTEST_RESULT_OK @endcode; otherwise @code EZTEST_RESULT_ERR @endcode.
+ */
+static int output_open(void)
+{
+    output_fd = STDOUT_FILENO;
+    if(options->output != NULL)
+    {
+        output_fd = open(options->output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(output_fd < 0)
+        {
+            fprintf(stderr, "Failed to open the output file '%s'.\n", options->output);
+            output_fd = STDOUT_FILENO;
+            return EZTEST_RESULT_ERR;
+        }
+    }
+    output_flush_time = monotonic_ms();
+
+    atexit(output_exit);
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_handler = output_on_signal;
+    for(size_t i = 0; i < sizeof(output_signals) / sizeof(output_signals[0]); i++)
+    {
+        sigaction(output_signals[i], &action, &output_old_actions[i]);
+    }
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&output_buffered, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_lock(&output_lock);
+    output_held = true;
+
+    // Signals are handled by the thread running the tests, the flush thread blocks them all.
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    // Without the thread the output is still flushed between tests.
+    output_thread_started = pthread_create(&output_thread, NULL, output_flusher, NULL) == 0;
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    return EZTEST_RESULT_OK;
+}
+
+/** Writes any remaining output and closes the output. */
+static void output_close(void)
+{
+    if(output_thread_started)
+    {
+        output_stopping = true;
+        pthread_cond_signal(&output_buffered);
+        pthread_mutex_unlock(&output_lock);
+        pthread_join(output_thread, NULL);
+        output_thread_started = false;
+        output_held = false;
+    }
+    output_flush();
+    if(output_fd != STDOUT_FILENO)
+    {
+        close(output_fd);
+        output_fd = STDOUT_FILENO;
+    }
+}
+
+//endregion output
+
+/**
+ * Writes the given bytes in hex, prefixed with 0x and enclosed in quotes.
+ *
+ * @param buffer Where to write the bytes, must have room for 2 * n + 8 chars.
+ * @param bytes  The bytes to write, NULL is written if @code NULL @endcode.
+ * @param n      The amount of bytes to write.
+ * @param more   Whether to mark that the value has more bytes than written.
+ */
+static void format_bytes(char *buffer, const unsigned char *bytes, const size_t n, const bool more)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    if(bytes == NULL)
+    {
+        strcpy(buffer, "NULL");
+        return;
+    }
+
+    *buffer++ = '\'';
+    *buffer++ = '0';
+    *buffer++ = 'x';
+    for(size_t i = 0; i < n; i++)
+    {
+        *buffer++ = digits[bytes[i] >> 4];
+        *buffer++ = digits[bytes[i] & 0xf];
+    }
+    if(more)
+    {
+        memcpy(buffer, "...", 3);
+        buffer += 3;
+    }
+    *buffer++ = '\'';
+    *buffer = '\0';
+}
+
+/**
+ * Reads the integer element of the given width at the given location.
+ *
+ * @param bytes     The location of the element.
+ * @param width     The size of the element, 1, 2, 4 or 8.
+ * @param is_signed Whether the element is a signed integer.
+ */
+static intmax_t read_element(const unsigned char *bytes, const size_t width, const bool is_signed)
+{
+    switch(width)
+    {
+        case 1: { uint8_t  v; memcpy(&v, bytes, 1); return is_signed ? (intmax_t)(int8_t)v  : (intmax_t)v; }
+        case 2: { uint16_t v; memcpy(&v, bytes, 2); return is_signed ? (intmax_t)(int16_t)v : (intmax_t)v; }
+        case 4: { uint32_t v; memcpy(&v, bytes, 4); return is_signed ? (intmax_t)(int32_t)v : (intmax_t)v; }
+        default:{ uint64_t v; memcpy(&v, bytes, 8); return (intmax_t)v; }
+    }
+}
+
+/**
+ * Writes the elements of the context window of an array, e.g. {.., 1, [2], 3, ..},
+ * where the first differing element is enclosed in brackets.
+ *
+ * @param buffer   Where to write the elements.
+ * @param size     The size of the buffer.
+ * @param diff     The array diff.
+ * @param elements The elements of the context window.
+ */
+static void format_elements(char *buffer, const size_t size, const struct array_diff *diff,
+                            const unsigned char *elements)
+{
+    if(elements == NULL)
+    {
+        snprintf(buffer, size, "NULL");
+        return;
+    }
+
+    size_t len = snprintf(buffer, size, "{%s", diff->start > 0 ? ".., " : "");
+    for(size_t i = 0; i < diff->window && len < size; i++)
+    {
+        const intmax_t value = read_element(elements + i * diff->width, diff->width, diff->is_signed);
+        const bool first = diff->start + i == diff->index;
+        const char *sep = i + 1 < diff->window ? ", " : "";
+        if(!diff->is_signed && diff->width == sizeof(uintmax_t))
+        {
+            len += snprintf(buffer + len, size - len, first ? "[%" PRIuMAX "]%s" : "%" PRIuMAX "%s", (uintmax_t)value, sep);
+        }
+        else
+        {
+            len += snprintf(buffer + len, size - len, first ? "[%" PRIdMAX "]%s" : "%" PRIdMAX "%s", value, sep);
+        }
+    }
+    if(len < size)
+    {
+        snprintf(buffer + len, size - len, "%s}", diff->start + diff->window < diff->count ? ", .." : "");
+    }
+}
+
+/**
+ * Appends to the given buffer. Like snprintf, nothing is written when the buffer is full
+ * but the length is still counted.
+ *
+ * @param buffer Where to write, may be @code NULL @endcode if size is 0 (zero).
+ * @param size   The size of the buffer.
+ * @param len    The length of what has been written so far.
+ * @return The new length.
+ */
+static size_t format_append(char *buffer, const size_t size, const size_t len, const char *fmt, ...)
+{
+    va_list va;
+    va_start(va, fmt);
+    const int n = vsnprintf(len < size ? buffer + len : NULL, len < size ? size - len : 0, fmt, va);
+    va_end(va);
+    return n < 0 ? len : len + n;
+}
+
+/**
+ * Writes the context window of two byte arrays as a hexdump with the expected bytes (-),
+ * the actual bytes (+) and a row marking the bytes that differ (^), e.g.
+ *
+ *   00000010  - 00 01 02 03  |....|
+ *             + 00 01 ff 03  |....|
+ *                     ^^       ^
+ *
+ * @param buffer Where to write, may be @code NULL @endcode if size is 0 (zero).
+ * @param size   The size of the buffer.
+ * @param len    The length of what has been written so far.
+ * @param diff   The diff of the byte arrays, its window starts at a row.
+ * @return The new length.
+ */
+static size_t format_hexdump(char *buffer, const size_t size, size_t len, const struct array_diff *diff)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    for(size_t row = 0; row < diff->window; row += EZTEST_HEXDUMP_WIDTH)
+    {
+        const size_t n = diff->window - row < EZTEST_HEXDUMP_WIDTH ? diff->window - row : EZTEST_HEXDUMP_WIDTH;
+        char hex[2][3 * EZTEST_HEXDUMP_WIDTH + 1];
+        char ascii[2][EZTEST_HEXDUMP_WIDTH + 1];
+        char marks[2][3 * EZTEST_HEXDUMP_WIDTH + 1];
+        bool differs = false;
+
+        memset(hex, ' ', sizeof(hex));
+        memset(ascii, ' ', sizeof(ascii));
+        memset(marks, ' ', sizeof(marks));
+        for(size_t i = 0; i < n; i++)
+        {
+            for(int j = 0; j < 2; j++)
+            {
+                const unsigned char c = diff->elements[j][row + i];
+                hex[j][3 * i]     = digits[c >> 4];
+                hex[j][3 * i + 1] = digits[c & 0xf];
+                ascii[j][i] = c >= 0x20 && c < 0x7f ? (char)c : '.';
+            }
+            if(diff->elements[0][row + i] != diff->elements[1][row + i])
+            {
+                marks[0][3 * i] = marks[0][3 * i + 1] = marks[1][i] = '^';
+                differs = true;
+            }
+        }
+        for(int j = 0; j < 2; j++)
+        {
+            hex[j][3 * EZTEST_HEXDUMP_WIDTH - 1] = ascii[j][EZTEST_HEXDUMP_WIDTH] = '\0';
+        }
+
+        len = format_append(buffer, size, len, "\n    %08zx  - %s  |%s|\n              + %s  |%s|",
+                            diff->start + row, hex[0], ascii[0], hex[1], ascii[1]);
+        if(differs)
+        {
+            size_t end = n;
+            while(marks[1][end - 1] == ' ') end--;
+            marks[0][3 * EZTEST_HEXDUMP_WIDTH - 1] = marks[1][end] = '\0';
+            len = format_append(buffer, size, len, "\n                %s   %s", marks[0], marks[1]);
+        }
+    }
+    return len;
+}
+
+/**
+ * Formats the failure message of the given failure.
+ *
+ * @param buffer  Where to write the message, may be @code NULL @endcode if size is 0 (zero).
+ * @param size    The size of the buffer.
+ * @param failure The failure to format.
+ * @return The length of the message, as returned by snprintf.
+ */
+static int format_failure(char *buffer, const size_t size, const struct failure *failure)
+{
+    const union operand *op = failure->operands;
+
+    switch(failure->type)
+    {
+        case operand_char:
+            return snprintf(buffer, size, failure->fmt, (int)op[0].i, (int)op[1].i);
+
+        case operand_int:
+            return snprintf(buffer, size, failure->fmt, op[0].i, op[1].i);
+
+        case operand_uint:
+            return snprintf(buffer, size, failure->fmt, op[0].u, op[1].u);
+
+        case operand_ldbl:
+            return snprintf(buffer, size, failure->fmt, op[0].ld, op[1].ld);
+
+        case operand_dbl:
+            return snprintf(buffer, size, failure->fmt, op[0].d, op[0].d, op[1].d, op[1].d);
+
+        case operand_str:
+            return snprintf(buffer, size, failure->fmt, op[0].str, op[1].str);
+
+        case operand_wstr:
+            return snprintf(buffer, size, failure->fmt, op[0].wstr, op[1].wstr);
+
+        case operand_mem:
+        {
+            char hex[2][2 * EZTEST_MAX_PRINTABLE_LEN + 8];
+            for(int i = 0; i < 2; i++)
+            {
+                const size_t n = op[i].mem.size > EZTEST_MAX_PRINTABLE_LEN ? EZTEST_MAX_PRINTABLE_LEN : op[i].mem.size;
+                format_bytes(hex[i], op[i].mem.bytes, n, op[i].mem.size > n);
+            }
+            return snprintf(buffer, size, failure->fmt, hex[0], hex[1]);
+        }
+
+        case operand_array:
+        {
+            const struct array_diff *diff = op[0].array;
+            if(diff == NULL)
+            {
+                return snprintf(buffer, size, "%s", failure->fmt);
+            }
+            char elements[2][(2 * EZTEST_ARRAY_CONTEXT + 1) * 24 + 16];
+            for(int i = 0; i < 2; i++)
+            {
+                format_elements(elements[i], sizeof(elements[i]), diff, diff->elements[i]);
+            }
+            return snprintf(buffer, size, failure->fmt, diff->mismatches, diff->count, diff->index,
+                            elements[0], elements[1]);
+        }
+
+        case operand_near:
+        {
+            const struct near_diff *diff = op[0].near;
+            if(diff == NULL)
+            {
+                return snprintf(buffer, size, "%s", failure->fmt);
+            }
+            const int digits = diff->width == sizeof(float) ? 9 : 17;
+            return snprintf(buffer, size, failure->fmt, diff->far, diff->count, diff->index,
+                            digits, diff->expected, digits, diff->actual, diff->error);
+        }
+
+        case operand_hexdump:
+        {
+            const struct array_diff *diff = op[0].array;
+            if(diff == NULL)
+            {
+                return snprintf(buffer, size, "%s", failure->fmt);
+            }
+            size_t len = format_append(buffer, size, 0, failure->fmt, diff->mismatches, diff->count, diff->index);
+            len = format_hexdump(buffer, size, len, diff);
+            return len > INT_MAX ? INT_MAX : (int)len;
+        }
+
+        case operand_stream:
+        {
+            const struct array_diff *diff = op[0].array;
+            if(diff == NULL)
+            {
+                return snprintf(buffer, size, "%s", failure->fmt);
+            }
+            size_t len = format_append(buffer, size, 0, failure->fmt, diff->index, op[1].u);
+            len = format_hexdump(buffer, size, len, diff);
+            return len > INT_MAX ? INT_MAX : (int)len;
+        }
+
+        default:
+            return snprintf(buffer, size, "%s", failure->fmt);
+    }
+}
+
+/**
+ * Gets the failure message of the given failure.
+ *
+ * @param failure The failure to get the message for.
+ * @return The formatted message. The message is only valid until the next call.
+ */
+static const char *failure_message(const struct failure *failure)
+{
+    static char *message = NULL;
+    static size_t message_size = 0;
+
+    const int len = format_failure(message, message_size, failure);
+    if(len < 0)
+    {
+        return "";
+    }
+    if((size_t)len >= message_size)
+    {
+        char *tmp = realloc(message, (size_t)len + 1);
+        if(tmp == NULL)
+        {
+            return message_size > 0 ? message : "";
+        }
+        message = tmp;
+        message_size = (size_t)len + 1;
+        format_failure(message, message_size, failure);
+    }
+    return message;
+}
+
+/** Prints an overall report of the test results. */
+static void print_report(const int pass, const int skip, const int fail)
+{
+    output_printf(
+           "-----------------------------------\n"
+           "|  "
+           "%sPASSED"  COLOR_NONE "  |  "
+           "%sSKIPPED" COLOR_NONE "  |  "
+           "%sFAILED"  COLOR_NONE "  |\n"
+           "-----------------------------------\n"
+           "| "
+           " %s%-7d" COLOR_NONE " | "
+           " %s%-8d" COLOR_NONE " | "
+           " %s%-7d" COLOR_NONE " |\n"
+           "-----------------------------------\n\n",
+           color(COLOR_GREEN) ,
+           color(COLOR_YELLOW),
+           color(COLOR_RED)   ,
+           color(COLOR_GREEN) , pass,
+           color(COLOR_YELLOW), skip,
+           color(COLOR_RED)   , fail);
+}
+
+/**
+ * Prints the test result output.
+ *
+ * @param test The unit test to print result for.
+ * @param time The test execution time in ms.
+ * @param resstr The string representing the result (Eg. PASS, FAIL etc)
+ * @param c The requested color of the output result string.
+ */
+static void print_result(const struct unit_test *test,
+                         const struct test_report *report,
+                         const char *restrict resstr,
+                         const char *restrict c)
+{
+    output_printf("|%s %s %s] %s : %s " COLOR_NONE,
+            // Print result with the given color.
+            color(c), resstr, COLOR_NONE, 
+            // Print test suite and name
+            test->test_suite, test->test_name);
+
+    if(options->timer)
+    {
+        output_printf("(%dms, %" PRIu64 " asserts)", report->time, report->asserts);
+    }
+    if(options->flag_empty && report->result == pass && report->asserts == 0)
+    {
+        output_printf("%s%s[no asserts]%s", options->timer ? " " : "", color(COLOR_YELLOW), COLOR_NONE);
+    }
+    output_write("\n", 1);
+    
+    for(const struct failure *failure = report->failures; failure != NULL; failure = failure->next)
+    {
+        output_printf("%s├── %s%s\n%s└──%s See file %s line %d ",
+                      COLOR_NONE, color(COLOR_YELLOW), failure_message(failure),
+                      COLOR_NONE, color(COLOR_YELLOW), extract_file_name(failure->file), failure->line);
+        if(failure->count > 1)
+        {
+            output_printf("(failed %zu times) ", failure->count);
+        }
+        output_printf("%s\n", COLOR_NONE);
+    }
+    if(report->suppressed > 0)
+    {
+        output_printf("%s└──%s %zu more failures suppressed. %s\n",
+                      COLOR_NONE, color(COLOR_YELLOW), report->suppressed, COLOR_NONE);
+    }
+    output_write("\n", 1);
+    output_result_done();
+}
+
+//region console reporter
+
+static void console_run_start(const int count)
+{
+    output_printf("Test discovery finished, found %d tests.\n\n", count);
+}
+
+static void console_test_start(const struct unit_test *test) {}
+
+/** The failures are printed with the test result, see @see print_result. */
+static void console_assert_fail(const struct unit_test *test, const struct failure *failure) {}
+
+static void console_test_end(const struct unit_test *test, const struct test_report *report)
+{
+    switch(report->result)
+    {
+        case fail:
+            print_result(test, report, "FAILED", COLOR_RED);
+            break;
+
+        case skip:
+            print_result(test, report, "SKIPPED", COLOR_YELLOW);
+            break;
+
+        default:
+            print_result(test, report, "PASSED", COLOR_GREEN);
+            break;
+    }
+}
+
+static void console_run_end(const struct run_report *report)
+{
+    print_report(report->pass, report->skip, report->fail);
+
+    if(options->timer)
+    {
+        output_printf("%-32s %8s %12s %10s\n", "Suite", "Tests", "Asserts", "Time");
+        for(size_t i = 0; i < report->suite_count; i++)
+        {
+            const struct suite_report *suite = &report->suites[i];
+            output_printf("%-32s %8d %12" PRIu64 " %8ums\n", suite->name, suite->tests, suite->asserts, suite->time);
+        }
+        output_write("\n", 1);
+        output_printf("Total elapsed time: %dms\n", report->time);
+    }
+    output_printf("Total asserts evaluated: %" PRIu64 " (%.0f per second)\n", report->asserts, report->assert_rate);
+
+    if(options->flag_empty && report->empty > 0)
+    {
+        output_printf("%s%d passing tests evaluated no asserts.%s\n", color(COLOR_YELLOW), report->empty, COLOR_NONE);
+    }
+}
+
+/** The default reporter, prints human readable results. */
+static const struct reporter console_reporter = {
+    .name        = "console",
+    .run_start   = console_run_start,
+    .test_start  = console_test_start,
+    .assert_fail = console_assert_fail,
+    .test_end    = console_test_end,
+    .run_end     = console_run_end
+};
+
+//endregion console reporter
+
+//region progress reporter
+
+/** The min time in ms between two redraws of the progress line. */
+#ifndef EZTEST_PROGRESS_INTERVAL
+#define EZTEST_PROGRESS_INTERVAL 100
+#endif
+
+/** Moves the cursor to the start of the line and clears the line. */
+#define CLEAR_LINE "\r\033[2K"
+
+/** The state of the progress line. */
+static struct
+{
+    /** The amount of discovered tests. */
+    int total;
+    /** The amount of finished tests. */
+    int done;
+    int pass;
+    int fail;
+    int skip;
+    /** The time the run started in ms. */
+    uint64_t start;
+    /** The time of the latest redraw in ms. */
+    uint64_t drawn;
+    /** The width of the terminal. */
+    int width;
+    /** The test currently running. */
+    const struct unit_test *test;
+} progress = { 0 };
+
+/** Redraws the progress line and writes it to the terminal. */
+static void progress_draw(const uint64_t now)
+{
+    const double elapsed = (double)(now - progress.start) / 1000;
+    const double eta = progress.done > 0 ? elapsed / progress.done * (progress.total - progress.done) : 0;
+
+    char line[512];
+    int len = snprintf(line, sizeof(line), "[%d/%d] pass %d | fail %d | skip %d | %.1fs | ETA %.1fs",
+                       progress.done, progress.total, progress.pass, progress.fail, progress.skip, elapsed, eta);
+    if(progress.test != NULL && len >= 0 && (size_t)len < sizeof(line))
+    {
+        snprintf(line + len, sizeof(line) - len, " | %s : %s", progress.test->test_suite, progress.test->test_name);
+    }
+    // Lines that wrap can not be redrawn, so the line is cut at the terminal width.
+    line[progress.width < (int)sizeof(line) ? progress.width : (int)sizeof(line) - 1] = '\0';
+
+    output_printf(CLEAR_LINE "%s%s%s", color(progress.fail > 0 ? COLOR_RED : COLOR_GREEN), line, COLOR_NONE);
+    output_flush();
+    progress.drawn = now;
+}
+
+/** Redraws the progress line if the progress interval has passed since the latest redraw. */
+static void progress_update(void)
+{
+    const uint64_t now = monotonic_ms();
+    if(now - progress.drawn >= EZTEST_PROGRESS_INTERVAL)
+    {
+        progress_draw(now);
+    }
+}
+
+static void progress_run_start(const int count)
+{
+    struct winsize ws;
+    progress.width = ioctl(output_fd, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 1 ? ws.ws_col - 1 : 79;
+    progress.total = count;
+    progress.start = monotonic_ms();
+    progress_draw(progress.start);
+}
+
+static void progress_test_start(const struct unit_test *test)
+{
+    progress.test = test;
+    progress_update();
+}
+
+static void progress_assert_fail(const struct unit_test *test, const struct failure *failure) {}
+
+static void progress_test_end(const struct unit_test *test, const struct test_report *report)
+{
+    progress.done++;
+    switch(report->result)
+    {
+        case fail:
+            progress.fail++;
+            // Failures are printed in full above the progress line.
+            output_write(CLEAR_LINE, sizeof(CLEAR_LINE) - 1);
+            print_result(test, report, "FAILED", COLOR_RED);
+            progress_draw(monotonic_ms());
+            return;
+
+        case skip:
+            progress.skip++;
+            break;
+
+        default:
+            progress.pass++;
+            break;
+    }
+    progress_update();
+}
+
+static void progress_run_end(const struct run_report *report)
+{
+    progress.test = NULL;
+    progress_draw(monotonic_ms());
+    output_write("\n\n", 2);
+    console_run_end(report);
+}
+
+/**
+ * Shows the progress on a single line that is redrawn at most every @see EZTEST_PROGRESS_INTERVAL ms.
+ * Only failed tests are printed in full.
+ */
+static const struct reporter progress_reporter = {
+    .name        = "progress",
+    .run_start   = progress_run_start,
+    .test_start  = progress_test_start,
+    .assert_fail = progress_assert_fail,
+    .test_end    = progress_test_end,
+    .run_end     = progress_run_end
+};
+
+//endregion progress reporter
+
+//region binary reporter
+
+/** Identifies the binary event stream, written at the start of the run start event. */
+#define EZTEST_BINARY_MAGIC "EZTB"
+
+/** The version of the binary event stream format. */
+#define EZTEST_BINARY_VERSION 1
+
+/** The event types of the binary event stream. */
+enum binary_event
+{
+    binary_run_start   = 1,
+    binary_test_start  = 2,
+    binary_assert_fail = 3,
+    binary_test_end    = 4,
+    binary_run_end     = 5
+};
+
+/** Holds the binary event that is currently being built. */
+static struct
+{
+    unsigned char *data;
+    size_t len;
+    size_t cap;
+} binary_event_buffer = { NULL, 0, 0 };
+
+/**
+ * Makes sure that the event buffer has room for n more bytes.
+ *
+ * @param n The amount of bytes that will be appended.
+ * @return @code true @endcode if there is room; otherwise @code false @endcode.
+ */
+static bool binary_reserve(const size_t n)
+{
+    if(binary_event_buffer.len + n <= binary_event_buffer.cap)
+    {
+        return true;
+    }
+    size_t cap = binary_event_buffer.cap == 0 ? 256 : binary_event_buffer.cap;
+    while(cap < binary_event_buffer.len + n)
+    {
+        cap *= 2;
+    }
+    unsigned char *data = realloc(binary_event_buffer.data, cap);
+    if(data == NULL)
+    {
+        return false;
+    }
+    binary_event_buffer.data = data;
+    binary_event_buffer.cap  = cap;
+    return true;
+}
+
+/** Appends an unsigned integer of the given byte width in little-endian order. */
+static void binary_put_uint(const uint64_t value, const int width)
+{
+    if(!binary_reserve(width)) return;
+
+    for(int i = 0; i < width; i++)
+    {
+        binary_event_buffer.data[binary_event_buffer.len++] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+/** Appends a string as a 32-bit length followed by the bytes of the string (no terminator). */
+static void binary_put_str(const char *str)
+{
+    const size_t len = str == NULL ? 0 : strlen(str);
+    binary_put_uint(len, 4);
+    if(len == 0 || !binary_reserve(len)) return;
+
+    memcpy(binary_event_buffer.data + binary_event_buffer.len, str, len);
+    binary_event_buffer.len += len;
+}
+
+/**
+ * Starts a new event. The length prefix is reserved and is filled in
+ * by @see binary_end_event.
+ */
+static void binary_begin_event(const enum binary_event type)
+{
+    binary_event_buffer.len = 0;
+    binary_put_uint(0, 4);
+    binary_put_uint(type, 1);
+}
+
+/** Fills in the length prefix and writes the event to the output. */
+static void binary_end_event(void)
+{
+    if(binary_event_buffer.len < 4) return;
+
+    const uint32_t len = (uint32_t)(binary_event_buffer.len - 4);
+    for(int i = 0; i < 4; i++)
+    {
+        binary_event_buffer.data[i] = (unsigned char)(len >> (8 * i));
+    }
+    output_write(binary_event_buffer.data, binary_event_buffer.len);
+}
+
+static void binary_run_start_event(const int count)
+{
+    binary_begin_event(binary_run_start);
+    if(binary_reserve(4))
+    {
+        memcpy(binary_event_buffer.data + binary_event_buffer.len, EZTEST_BINARY_MAGIC, 4);
+        binary_event_buffer.len += 4;
+    }
+    binary_put_uint(EZTEST_BINARY_VERSION, 2);
+    binary_put_uint(count, 4);
+    binary_end_event();
+}
+
+static void binary_test_start_event(const struct unit_test *test)
+{
+    binary_begin_event(binary_test_start);
+    binary_put_str(test->test_suite);
+    binary_put_str(test->test_name);
+    binary_end_event();
+}
+
+static void binary_assert_fail_event(const struct unit_test *test, const struct failure *failure)
+{
+    binary_begin_event(binary_assert_fail);
+    binary_put_str(failure->file);
+    binary_put_uint(failure->line, 4);
+    binary_put_uint(failure->count, 4);
+    binary_put_str(failure_message(failure));
+    binary_end_event();
+}
+
+static void binary_test_end_event(const struct unit_test *test, const struct test_report *report)
+{
+    binary_begin_event(binary_test_end);
+    binary_put_uint(report->result, 1);
+    binary_put_uint(report->time, 4);
+    binary_put_uint(report->suppressed, 4);
+    binary_put_uint(report->asserts, 8);
+    binary_end_event();
+    output_result_done();
+}
+
+static void binary_run_end_event(const struct run_report *report)
+{
+    binary_begin_event(binary_run_end);
+    binary_put_uint(report->pass, 4);
+    binary_put_uint(report->skip, 4);
+    binary_put_uint(report->fail, 4);
+    binary_put_uint(report->time, 4);
+    binary_put_uint(report->asserts, 8);
+    binary_end_event();
+
+    free(binary_event_buffer.data);
+    binary_event_buffer.data = NULL;
+    binary_event_buffer.cap  = 0;
+}
+
+/**
+ * Writes the test events as a compact stream of length-prefixed binary events.
+ * See doc/reporters.md for a description of the format.
+ */
+static const struct reporter binary_reporter = {
+    .name        = "binary",
+    .run_start   = binary_run_start_event,
+    .test_start  = binary_test_start_event,
+    .assert_fail = binary_assert_fail_event,
+    .test_end    = binary_test_end_event,
+    .run_end     = binary_run_end_event
+};
+
+//endregion binary reporter
+
+static void quiet_run_start(const int count) {}
+static void quiet_test_start(const struct unit_test *test) {}
+static void quiet_assert_fail(const struct unit_test *test, const struct failure *failure) {}
+static void quiet_test_end(const struct unit_test *test, const struct test_report *report) {}
+static void quiet_run_end(const struct run_report *report) {}
+
+/** Used when the quiet option is set, ignores all events. */
+static const struct reporter quiet_reporter = {
+    .name        = "quiet",
+    .run_start   = quiet_run_start,
+    .test_start  = quiet_test_start,
+    .assert_fail = quiet_assert_fail,
+    .test_end    = quiet_test_end,
+    .run_end     = quiet_run_end
+};
+
+/** The reporters that can be selected from the command line. */
+static const struct reporter *const reporters[] = { &console_reporter, &binary_reporter };
+
+/**
+ * Finds the reporter with the given name.
+ *
+ * @param name The name of the reporter (not NULL).
+ * @return The reporter with the given name or @code NULL @endcode if there is no such reporter.
+ */
+static const struct reporter *find_reporter(const char *name)
+{
+    assert(name != NULL);
+
+    for(size_t i = 0; i < sizeof(reporters) / sizeof(reporters[0]); i++)
+    {
+        if(strcmp(reporters[i]->name, name) == 0)
+        {
+            return reporters[i];
+        }
+    }
+    return NULL;
+}
+
+//region forked results
+
+/** The write end of the pipe to the runner process, only open in a forked test process. */
+static int result_pipe = -1;
+
+/**
+ * The kinds of records sent from a forked test process. Failures and snapshots are sent as they
+ * are registered, so that they reach the runner process even when the test process crashes.
+ */
+enum forked_record
+{
+    /** Followed by a struct forked_failure. */
+    forked_failure_record,
+    /** An assert that was not reported due to the max failures option, without data. */
+    forked_suppressed_record,
+    /** Followed by a struct forked_snapshot. */
+    forked_snapshot_record,
+    /** Followed by a struct forked_result, sent once the test has finished. */
+    forked_result_record
+};
+
+/** A failure sent from a forked test process, followed by the file name and the message. */
+struct forked_failure
+{
+    int line;
+    size_t file_size;
+    size_t message_size;
+};
+
+/** A snapshot reached by a forked test process while recording, followed by its key and its block hashes if recorded. */
+struct forked_snapshot
+{
+    uint64_t size;
+    uint64_t hash;
+    size_t key_size;
+    bool blocks;
+};
+
+/** The result sent from a forked test process, followed by the repeat count of each failure in order. */
+struct forked_result
+{
+    enum test_result result;
+    unsigned int time;
+    uint64_t asserts;
+    size_t failures;
+};
+
+/** Sends the kind of a record from a forked test process to the runner process. */
+static void send_record(const enum forked_record kind)
+{
+    write_all(result_pipe, &kind, sizeof(kind));
+}
+
+/** Sends the given failure from a forked test process as a formatted message. */
+static void send_failure(const struct failure *failure)
+{
+    const int len = format_failure(NULL, 0, failure);
+    char *message = malloc(len > 0 ? (size_t)len + 1 : 1);
+    const struct forked_failure sent = {
+        .line         = failure->line,
+        .file_size    = strlen(failure->file),
+        .message_size = message == NULL || len < 0 ? 0 : (size_t)len
+    };
+    if(message != NULL)
+    {
+        format_failure(message, sent.message_size + 1, failure);
+    }
+    send_record(forked_failure_record);
+    write_all(result_pipe, &sent, sizeof(sent));
+    write_all(result_pipe, failure->file, sent.file_size);
+    write_all(result_pipe, message, sent.message_size);
+    free(message);
+}
+
+/**
+ * Sends a snapshot reached by a forked test process, the runner process writes it to the snapshot file.
+ *
+ * @param blocks The block hashes, @code NULL @endcode if they are not recorded.
+ */
+static void send_snapshot(const char *key, const uint64_t size, const uint64_t hash, const uint64_t *blocks,
+                          const size_t block_count)
+{
+    const struct forked_snapshot sent = {
+        .size     = size,
+        .hash     = hash,
+        .key_size = strlen(key),
+        .blocks   = blocks != NULL
+    };
+    send_record(forked_snapshot_record);
+    write_all(result_pipe, &sent, sizeof(sent));
+    write_all(result_pipe, key, sent.key_size);
+    if(blocks != NULL)
+    {
+        write_all(result_pipe, blocks, block_count * sizeof(uint64_t));
+    }
+}
+
+/**
+ * Sends the result of the current test from a forked test process to the runner process,
+ * along with the final repeat counts of the failures sent before.
+ */
+static void send_result(const unsigned int time)
+{
+    const struct forked_result header = {
+        .result   = result,
+        .time     = time,
+        .asserts  = eztest_assert_count,
+        .failures = failure_count
+    };
+    send_record(forked_result_record);
+    write_all(result_pipe, &header, sizeof(header));
+    for(const struct failure *failure = failures; failure != NULL; failure = failure->next)
+    {
+        write_all(result_pipe, &failure->count, sizeof(failure->count));
+    }
+}
+
+//endregion forked results
+
+/** Hashes the file, line and message of an assert for the failure table. */
+static size_t failure_hash(const char *file, const int line, const char *fmt)
+{
+    const uint64_t h = ((uint64_t)(uintptr_t)file ^ (uint64_t)(uintptr_t)fmt * 0xC2B2AE3D27D4EB4Fu ^
+                        (uint64_t)line * 0x9E3779B97F4A7C15u) * 0xFF51AFD7ED558CCDu;
+    return (size_t)(h ^ (h >> 32));
+}
+
+/**
+ * Finds the failure slot of the given assert in the failure table, growing the table when needed.
+ * Asserts are identified by their file, line and message format so that different asserts on
+ * the same line are kept apart.
+ *
+ * @param file The file of the assert.
+ * @param line The line of the assert.
+ * @param fmt  The failure message format of the assert.
+ * @return The slot holding the failure of the assert, or the empty slot where it should
+ *         be stored. @code NULL @endcode if out of memory.
+ */
+static struct failure_slot *find_failure_slot(const char *file, const int line, const char *fmt)
+{
+    const size_t generation = failure_table.generation;
+    if(failure_table.cap < 2 * (failure_table.count + 1))
+    {
+        const size_t cap = failure_table.cap == 0 ? 16 : 2 * failure_table.cap;
+        struct failure_slot *slots = calloc(cap, sizeof(struct failure_slot));
+        if(slots == NULL)
+        {
+            return NULL;
+        }
+        for(size_t i = 0; i < failure_table.cap; i++)
+        {
+            if(failure_table.slots[i].generation != generation) continue;
+
+            const struct failure *failure = failure_table.slots[i].failure;
+            size_t j = failure_hash(failure->file, failure->line, failure->fmt) & (cap - 1);
+            while(slots[j].generation == generation)
+            {
+                j = (j + 1) & (cap - 1);
+            }
+            slots[j] = failure_table.slots[i];
+        }
+        free(failure_table.slots);
+        failure_table.slots = slots;
+        failure_table.cap = cap;
+    }
+
+    size_t i = failure_hash(file, line, fmt) & (failure_table.cap - 1);
+    while(failure_table.slots[i].generation == generation &&
+          (failure_table.slots[i].failure->file != file ||
+           failure_table.slots[i].failure->line != line ||
+           failure_table.slots[i].failure->fmt  != fmt))
+    {
+        i = (i + 1) & (failure_table.cap - 1);
+    }
+    return &failure_table.slots[i];
+}
+
+/**
+ * Copies the given string to the failure arena.
+ *
+ * @param str The string to copy, may be @code NULL @endcode.
+ * @return The copy, or @code NULL @endcode if str is @code NULL @endcode or out of memory.
+ */
+static const char *copy_str(const char *str)
+{
+    if(str == NULL) return NULL;
+
+    const size_t size = strlen(str) + 1;
+    char *copy = arena_alloc(&failure_arena, size);
+    if(copy != NULL)
+    {
+        memcpy(copy, str, size);
+    }
+    return copy;
+}
+
+/** @see copy_str */
+static const wchar_t *copy_wstr(const wchar_t *wstr)
+{
+    if(wstr == NULL) return NULL;
+
+    const size_t size = (wcslen(wstr) + 1) * sizeof(wchar_t);
+    wchar_t *copy = arena_alloc(&failure_arena, size);
+    if(copy != NULL)
+    {
+        memcpy(copy, wstr, size);
+    }
+    return copy;
+}
+
+/**
+ * Copies the given array diff, along with its context windows, to the failure arena.
+ *
+ * @param diff The diff to copy.
+ * @return The copy, or @code NULL @endcode if out of memory.
+ */
+static const struct array_diff *copy_array_diff(const struct array_diff *diff)
+{
+    const size_t size = diff->window * diff->width;
+    struct array_diff *copy = arena_alloc(&failure_arena, sizeof(struct array_diff) + 2 * size);
+    if(copy == NULL) return NULL;
+
+    *copy = *diff;
+    unsigned char *elements = (unsigned char *)(copy + 1);
+    for(int i = 0; i < 2; i++)
+    {
+        if(diff->elements[i] != NULL)
+        {
+            memcpy(elements + i * size, diff->elements[i], size);
+            copy->elements[i] = elements + i * size;
+        }
+    }
+    return copy;
+}
+
+/**
+ * Registers the current test as a failure and stores the given failure message
+ * along with its operands so that it can be formatted when the test is reported.
+ * Repeated failures of the same assert (file, line and message) are only counted.
+ *
+ * @param type The type of the message arguments.
+ * @param msg  The failure message format string. Must be a string literal.
+ * @param ...  Message arguments, either none or two of the given type. Memory
+ *             operands are passed as a pointer followed by a size_t size. Array
+ *             operands are passed as a single pointer to a struct array_diff, near
+ *             operands as a single pointer to a struct near_diff. Stream operands
+ *             are passed as a pointer to a struct array_diff followed by a uintmax_t.
+ */
+static void register_fail(char *file, const int line, const enum operand_type type, const char *msg, ...)
+{
+    // A property test only needs to know whether the asserts fail for the arguments it tries.
+    if(property_probe)
+    {
+        property_failed = true;
+        return;
+    }
+    result = fail;
+    
+    if(options->quiet)
+    {
+        return;
+    }
+
+    struct failure_slot *slot = find_failure_slot(file, line, msg);
+    if(slot == NULL)
+    {
+        return;
+    }
+    if(slot->generation == failure_table.generation)
+    {
+        slot->failure->count++;
+        return;
+    }
+
+    struct failure *failure = arena_alloc(&failure_arena, sizeof(struct failure));
+    if(failure == NULL)
+    {
+        return;
+    }
+    failure->next       = NULL;
+    failure->file       = file;
+    failure->line       = line;
+    failure->count      = 1;
+    failure->suppressed = options->max_failures > 0 && failure_count >= options->max_failures;
+    failure->fmt        = msg;
+    failure->type       = type;
+    slot->failure       = failure;
+    slot->generation    = failure_table.generation;
+    failure_table.count++;
+
+    // A suppressed assert is kept in the table so that its repeats are not counted again.
+    if(failure->suppressed)
+    {
+        failure->type = operand_none;
+        suppressed_count++;
+        if(result_pipe >= 0)
+        {
+            send_record(forked_suppressed_record);
+        }
+        return;
+    }
+
+    va_list va;
+    va_start(va, msg);
+    for(int i = 0; i < 2 && type != operand_none; i++)
+    {
+        union operand *op = &failure->operands[i];
+        switch(type)
+        {
+            case operand_char:
+            case operand_int:
+                op->i = va_arg(va, intmax_t);
+                break;
+
+            case operand_uint:
+                op->u = va_arg(va, uintmax_t);
+                break;
+
+            case operand_ldbl:
+                op->ld = va_arg(va, long double);
+                break;
+
+            case operand_dbl:
+                op->d = va_arg(va, double);
+                break;
+
+            case operand_str:
+                op->str = copy_str(va_arg(va, const char *));
+                break;
+
+            case operand_wstr:
+                op->wstr = copy_wstr(va_arg(va, const wchar_t *));
+                break;
+
+            case operand_mem:
+            {
+                const unsigned char *bytes = va_arg(va, const unsigned char *);
+                const size_t size = va_arg(va, size_t);
+                const size_t n = size > EZTEST_MAX_PRINTABLE_LEN ? EZTEST_MAX_PRINTABLE_LEN : size;
+                unsigned char *copy = bytes == NULL ? NULL : arena_alloc(&failure_arena, n);
+                if(copy != NULL)
+                {
+                    memcpy(copy, bytes, n);
+                }
+                op->mem.bytes = copy;
+                op->mem.size  = copy == NULL ? 0 : size;
+                break;
+            }
+
+            case operand_array:
+            case operand_hexdump:
+                if(i == 0)
+                {
+                    op->array = copy_array_diff(va_arg(va, const struct array_diff *));
+                }
+                break;
+
+            case operand_stream:
+                if(i == 0)
+                {
+                    op->array = copy_array_diff(va_arg(va, const struct array_diff *));
+                }
+                else
+                {
+                    op->u = va_arg(va, uintmax_t);
+                }
+                break;
+
+            case operand_near:
+                if(i == 0)
+                {
+                    struct near_diff *copy = arena_alloc(&failure_arena, sizeof(struct near_diff));
+                    if(copy != NULL)
+                    {
+                        *copy = *va_arg(va, const struct near_diff *);
+                    }
+                    op->near = copy;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+    va_end(va);
+
+    failure_count++;
+    *failures_tail = failure;
+    failures_tail = &failure->next;
+    if(result_pipe >= 0)
+    {
+        send_failure(failure);
+    }
+}
+
+//endregion printers
+
+//region text diff
+
+/** The amount of unchanged lines printed around each change of a text diff. */
+#define EZTEST_TEXT_CONTEXT 3
+
+/** The max amount of lines of a printed text diff, longer diffs are cut. */
+#define EZTEST_TEXT_MAX_LINES 64
+
+/** The max amount of chars printed of each line of a text diff, longer lines are cut around the change. */
+#define EZTEST_TEXT_MAX_LINE_LEN 160
+
+/** The max amount of char edits between two paired lines, lines that differ more are marked as one change. */
+#define EZTEST_TEXT_MAX_CHAR_EDITS 64
+
+/** A line of a text. */
+struct text_line
+{
+    const char *text;
+    size_t len;
+    uint64_t hash;
+};
+
+/** A line of a text diff, see @see text_diff_script. */
+struct text_edit
+{
+    /** ' ' for a line of both texts, '-' for a line only in the expected text and '+' for a line only in the actual text. */
+    char type;
+    /** The index of the line in the expected text, or of the next line if the line is only in the actual text. */
+    size_t a;
+    /** @see a, for the actual text. */
+    size_t b;
+};
+
+/** The state of a text diff. */
+struct text_diff
+{
+    const struct text_line *a;
+    const struct text_line *b;
+    /** Set for each line of the expected text that is not in the actual text. */
+    bool *deleted;
+    /** Set for each line of the actual text that is not in the expected text. */
+    bool *inserted;
+    /** The furthest reaching forward and backward paths, indexed by diagonal. */
+    ptrdiff_t *fd;
+    ptrdiff_t *bd;
+    /** The cost after which the search for the middle snake settles for a good split. */
+    ptrdiff_t max_cost;
+};
+
+/**
+ * Splits the given text into lines, the line breaks are not part of the lines.
+ *
+ * @param text  The text to split.
+ * @param count Set to the amount of lines.
+ * @return The lines, or @code NULL @endcode if out of memory. Must be freed by the caller.
+ */
+static struct text_line *text_lines(const char *text, size_t *count)
+{
+    // A line break ends a line, so text that ends with a line break has no empty last line.
+    const size_t size = strlen(text);
+    size_t n = size > 0 && text[size - 1] != '\n';
+    for(const char *c = memchr(text, '\n', size); c != NULL; c = memchr(c + 1, '\n', size - (c + 1 - text)))
+    {
+        n++;
+    }
+
+    struct text_line *lines = malloc((n + 1) * sizeof(struct text_line));
+    if(lines == NULL) return NULL;
+
+    for(size_t i = 0; i < n; i++)
+    {
+        const char *end = strchr(text, '\n');
+        const size_t len = end == NULL ? strlen(text) : (size_t)(end - text);
+        uint64_t hash = 0xcbf29ce484222325u;
+        for(size_t j = 0; j < len; j++)
+        {
+            hash = (hash ^ (unsigned char)text[j]) * 0x100000001b3u;
+        }
+        lines[i] = (struct text_line){ .text = text, .len = len, .hash = hash };
+        text += len + 1;
+    }
+    *count = n;
+    return lines;
+}
+
+static inline bool text_line_equal(const struct text_diff *diff, const ptrdiff_t x, const ptrdiff_t y)
+{
+    const struct text_line *a = &diff->a[x], *b = &diff->b[y];
+    return a->hash == b->hash && a->len == b->len && memcmp(a->text, b->text, a->len) == 0;
+}
+
+/**
+ * Finds the midpoint of the shortest edit script of the given ranges of the texts, the middle
+ * snake of Myers' linear space diff. When the search costs more than max_cost the point that
+ * reached furthest is used instead, so the diff may not be minimal but stays fast.
+ * The ranges must not start or end with equal lines.
+ */
+static void text_split(struct text_diff *diff, const ptrdiff_t xoff, const ptrdiff_t xlim,
+                       const ptrdiff_t yoff, const ptrdiff_t ylim, ptrdiff_t *xmid, ptrdiff_t *ymid)
+{
+    ptrdiff_t *const fd = diff->fd;
+    ptrdiff_t *const bd = diff->bd;
+    const ptrdiff_t dmin = xoff - ylim, dmax = xlim - yoff;
+    const ptrdiff_t fmid = xoff - yoff, bmid = xlim - ylim;
+    ptrdiff_t fmin = fmid, fmax = fmid, bmin = bmid, bmax = bmid;
+    const bool odd = (fmid - bmid) & 1;
+
+    fd[fmid] = xoff;
+    bd[bmid] = xlim;
+    for(ptrdiff_t cost = 1;; cost++)
+    {
+        if(fmin > dmin) fd[--fmin - 1] = -1; else ++fmin;
+        if(fmax < dmax) fd[++fmax + 1] = -1; else --fmax;
+        for(ptrdiff_t d = fmax; d >= fmin; d -= 2)
+        {
+            ptrdiff_t x = fd[d - 1] >= fd[d + 1] ? fd[d - 1] + 1 : fd[d + 1];
+            ptrdiff_t y = x - d;
+            while(x < xlim && y < ylim && text_line_equal(diff, x, y))
+            {
+                x++, y++;
+            }
+            fd[d] = x;
+            if(odd && bmin <= d && d <= bmax && bd[d] <= x)
+            {
+                *xmid = x, *ymid = y;
+                return;
+            }
+        }
+
+        if(bmin > dmin) bd[--bmin - 1] = PTRDIFF_MAX; else ++bmin;
+        if(bmax < dmax) bd[++bmax + 1] = PTRDIFF_MAX; else --bmax;
+        for(ptrdiff_t d = bmax; d >= bmin; d -= 2)
+        {
+            ptrdiff_t x = bd[d - 1] < bd[d + 1] ? bd[d - 1] : bd[d + 1] - 1;
+            ptrdiff_t y = x - d;
+            while(x > xoff && y > yoff && text_line_equal(diff, x - 1, y - 1))
+            {
+                x--, y--;
+            }
+            bd[d] = x;
+            if(!odd && fmin <= d && d <= fmax && x <= fd[d])
+            {
+                *xmid = x, *ymid = y;
+                return;
+            }
+        }
+
+        if(cost >= diff->max_cost)
+        {
+            ptrdiff_t fxybest = -1, fxbest = 0;
+            for(ptrdiff_t d = fmax; d >= fmin; d -= 2)
+            {
+                ptrdiff_t x = fd[d] < xlim ? fd[d] : xlim;
+                ptrdiff_t y = x - d;
+                if(ylim < y) x = ylim + d, y = ylim;
+                if(fxybest < x + y) fxybest = x + y, fxbest = x;
+            }
+            ptrdiff_t bxybest = PTRDIFF_MAX, bxbest = 0;
+            for(ptrdiff_t d = bmax; d >= bmin; d -= 2)
+            {
+                ptrdiff_t x = bd[d] > xoff ? bd[d] : xoff;
+                ptrdiff_t y = x - d;
+                if(y < yoff) x = yoff + d, y = yoff;
+                if(x + y < bxybest) bxybest = x + y, bxbest = x;
+            }
+            if((xlim + ylim) - bxybest < fxybest - (xoff + yoff))
+            {
+                *xmid = fxbest, *ymid = fxybest - fxbest;
+            }
+            else
+            {
+                *xmid = bxbest, *ymid = bxybest - bxbest;
+            }
+            return;
+        }
+    }
+}
+
+/** Marks the lines of the given ranges of the texts that are not part of the other text. */
+static void text_compare(struct text_diff *diff, ptrdiff_t xoff, ptrdiff_t xlim, ptrdiff_t yoff, ptrdiff_t ylim)
+{
+    while(xoff < xlim && yoff < ylim && text_line_equal(diff, xoff, yoff))
+    {
+        xoff++, yoff++;
+    }
+    while(xoff < xlim && yoff < ylim && text_line_equal(diff, xlim - 1, ylim - 1))
+    {
+        xlim--, ylim--;
+    }
+
+    if(xoff == xlim)
+    {
+        while(yoff < ylim) diff->inserted[yoff++] = true;
+    }
+    else if(yoff == ylim)
+    {
+        while(xoff < xlim) diff->deleted[xoff++] = true;
+    }
+    else
+    {
+        ptrdiff_t xmid, ymid;
+        text_split(diff, xoff, xlim, yoff, ylim, &xmid, &ymid);
+        text_compare(diff, xoff, xmid, yoff, ymid);
+        text_compare(diff, xmid, xlim, ymid, ylim);
+    }
+}
+
+/** A growable string used to build a text diff. */
+struct text_buffer
+{
+    char *data;
+    size_t len;
+    size_t cap;
+};
+
+static void text_append(struct text_buffer *buffer, const char *str, const size_t len)
+{
+    if(buffer->len + len + 1 > buffer->cap)
+    {
+        size_t cap = buffer->cap == 0 ? 1024 : buffer->cap;
+        while(buffer->len + len + 1 > cap) cap *= 2;
+        char *data = realloc(buffer->data, cap);
+        if(data == NULL) return;
+        buffer->data = data;
+        buffer->cap = cap;
+    }
+    memcpy(buffer->data + buffer->len, str, len);
+    buffer->len += len;
+    buffer->data[buffer->len] = '\0';
+}
+
+/**
+ * Marks the chars of the line that are not part of the other line, with Myers' greedy diff of
+ * the chars between their common prefix and suffix. When the lines differ in more than
+ * EZTEST_TEXT_MAX_CHAR_EDITS chars, all chars between the common prefix and suffix are marked.
+ *
+ * @param changed Set for each changed char of the line, must hold line->len entries.
+ */
+static void text_char_diff(const struct text_line *line, const struct text_line *other, bool *changed)
+{
+    const size_t min = line->len < other->len ? line->len : other->len;
+    size_t prefix_len = 0, suffix_len = 0;
+    while(prefix_len < min && line->text[prefix_len] == other->text[prefix_len]) prefix_len++;
+    while(suffix_len < min - prefix_len &&
+          line->text[line->len - 1 - suffix_len] == other->text[other->len - 1 - suffix_len]) suffix_len++;
+
+    const char *a = line->text + prefix_len, *b = other->text + prefix_len;
+    const ptrdiff_t n = (ptrdiff_t)(line->len - prefix_len - suffix_len);
+    const ptrdiff_t m = (ptrdiff_t)(other->len - prefix_len - suffix_len);
+    memset(changed, 0, line->len);
+
+    // The furthest reaching x of each diagonal k after each cost d, at trace[d * width + k + max].
+    const ptrdiff_t max = n + m < EZTEST_TEXT_MAX_CHAR_EDITS ? n + m : EZTEST_TEXT_MAX_CHAR_EDITS;
+    const ptrdiff_t width = 2 * max + 3;
+    ptrdiff_t *trace = n == 0 || m == 0 ? NULL : malloc((size_t)((max + 1) * width) * sizeof(ptrdiff_t));
+    ptrdiff_t cost = -1;
+    for(ptrdiff_t d = 0; trace != NULL && d <= max && cost < 0; d++)
+    {
+        const ptrdiff_t *prev = d == 0 ? NULL : trace + (d - 1) * width + max + 1;
+        ptrdiff_t *v = trace + d * width + max + 1;
+        for(ptrdiff_t k = -d; k <= d; k += 2)
+        {
+            ptrdiff_t x = d == 0 ? 0 : k == -d || (k != d && prev[k - 1] < prev[k + 1]) ? prev[k + 1] : prev[k - 1] + 1;
+            ptrdiff_t y = x - k;
+            while(x < n && y < m && a[x] == b[y])
+            {
+                x++, y++;
+            }
+            v[k] = x;
+            if(x >= n && y >= m)
+            {
+                cost = d;
+                break;
+            }
+        }
+    }
+    if(cost < 0)
+    {
+        // Too many edits, or only chars of one of the lines between the common prefix and suffix.
+        memset(changed + prefix_len, 1, (size_t)n);
+        free(trace);
+        return;
+    }
+
+    // Walks the edit script back, marking the chars deleted from the line.
+    ptrdiff_t x = n, y = m;
+    for(ptrdiff_t d = cost; d > 0; d--)
+    {
+        const ptrdiff_t *prev = trace + (d - 1) * width + max + 1;
+        const ptrdiff_t k = x - y;
+        const bool deleted = !(k == -d || (k != d && prev[k - 1] < prev[k + 1]));
+        const ptrdiff_t prev_x = deleted ? prev[k - 1] : prev[k + 1];
+        if(deleted)
+        {
+            changed[prefix_len + (size_t)prev_x] = true;
+        }
+        x = prev_x;
+        y = prev_x - (deleted ? k - 1 : k + 1);
+    }
+    free(trace);
+}
+
+/**
+ * Appends a line of a text diff. When other is given, the runs of chars of the line that are
+ * not part of other are enclosed in the given markers. Long lines are cut around the first change.
+ *
+ * @param prefix  The diff prefix of the line: ' ', '-' or '+'.
+ * @param line    The line.
+ * @param other   The line that this line was changed from or to, may be @code NULL @endcode.
+ * @param markers The opening and closing markers of the changed chars.
+ */
+static void text_append_line(struct text_buffer *buffer, const char prefix, const struct text_line *line,
+                             const struct text_line *other, const char *const markers[2])
+{
+    char head[8] = { '\n', ' ', ' ', ' ', ' ', prefix };
+    text_append(buffer, head, 6);
+
+    bool *changed = other == NULL || line->len == 0 ? NULL : malloc(line->len);
+    size_t start = 0, end = line->len, change_start = 0;
+    if(changed != NULL)
+    {
+        text_char_diff(line, other, changed);
+        while(change_start < line->len && !changed[change_start]) change_start++;
+    }
+    if(end - start > EZTEST_TEXT_MAX_LINE_LEN)
+    {
+        // Shows some of the line before the change, and as much as fits after it.
+        start = changed != NULL && change_start > EZTEST_TEXT_MAX_LINE_LEN / 4 ? change_start - EZTEST_TEXT_MAX_LINE_LEN / 4 : 0;
+        end = start + EZTEST_TEXT_MAX_LINE_LEN < line->len ? start + EZTEST_TEXT_MAX_LINE_LEN : line->len;
+    }
+
+    if(start > 0) text_append(buffer, "...", 3);
+    if(changed != NULL)
+    {
+        for(size_t i = start; i < end;)
+        {
+            size_t j = i;
+            while(j < end && changed[j] == changed[i]) j++;
+            if(changed[i]) text_append(buffer, markers[0], strlen(markers[0]));
+            text_append(buffer, line->text + i, j - i);
+            if(changed[i]) text_append(buffer, markers[1], strlen(markers[1]));
+            i = j;
+        }
+    }
+    else
+    {
+        text_append(buffer, line->text + start, end - start);
+    }
+    if(end < line->len) text_append(buffer, "...", 3);
+    free(changed);
+}
+
+/**
+ * Creates the unified diff of the two texts. Lines of both texts are compared with a linear space
+ * Myers diff, and each changed line is compared char by char with the line it was changed to,
+ * see @see text_char_diff(line, other, changed);
+ *
+ * @param expected The expected text.
+ * @param actual   The actual text.
+ * @param summary  Where to write a summary of the diff.
+ * @param size     The size of summary.
+ * @return The diff, or @code NULL @endcode if out of memory. Must be freed by the caller.
+ */
+static char *text_diff(const char *expected, const char *actual, char *summary, const size_t size)
+{
+    static const char *const removed[2] = { "[-", "-]" };
+    static const char *const added[2]   = { "{+", "+}" };
+
+    size_t nx = 0, ny = 0;
+    struct text_line *a = text_lines(expected, &nx);
+    struct text_line *b = text_lines(actual, &ny);
+    const size_t diags = nx + ny + 3;
+    struct text_diff diff = {
+        .a = a,
+        .b = b,
+        .deleted  = calloc(nx + 1, sizeof(bool)),
+        .inserted = calloc(ny + 1, sizeof(bool)),
+        .fd = malloc(2 * diags * sizeof(ptrdiff_t)),
+        .max_cost = 1
+    };
+    struct text_edit *edits = malloc((nx + ny) * sizeof(struct text_edit));
+    struct text_buffer buffer = { 0 };
+
+    if(a == NULL || b == NULL || diff.deleted == NULL || diff.inserted == NULL || diff.fd == NULL || edits == NULL)
+    {
+        goto done;
+    }
+    // The diagonals range from -(ny + 1) to nx + 1.
+    diff.bd = diff.fd + diags + ny + 1;
+    diff.fd += ny + 1;
+    // About the square root of the amount of diagonals, as in GNU diff.
+    for(size_t d = diags; d != 0; d >>= 2)
+    {
+        diff.max_cost <<= 1;
+    }
+    if(diff.max_cost < 256) diff.max_cost = 256;
+
+    text_compare(&diff, 0, (ptrdiff_t)nx, 0, (ptrdiff_t)ny);
+
+    // The edit script, deleted lines before inserted lines of each change.
+    size_t count = 0, deletions = 0, insertions = 0;
+    for(size_t i = 0, j = 0; i < nx || j < ny;)
+    {
+        const char type = i < nx && diff.deleted[i] ? '-' : j < ny && diff.inserted[j] ? '+' : ' ';
+        edits[count++] = (struct text_edit){ .type = type, .a = i, .b = j };
+        if(type != '+') i++;
+        if(type != '-') j++;
+        deletions  += type == '-';
+        insertions += type == '+';
+    }
+    if(deletions == 0 && insertions == 0)
+    {
+        snprintf(summary, size, "the texts only differ in the line break at the end");
+    }
+    else
+    {
+        snprintf(summary, size, "%zu of %zu lines removed, %zu of %zu lines added", deletions, nx, insertions, ny);
+    }
+
+    size_t printed = 0;
+    for(size_t k = 0; k < count && printed < EZTEST_TEXT_MAX_LINES;)
+    {
+        while(k < count && edits[k].type == ' ') k++;
+        if(k == count) break;
+
+        // A hunk spans the changes that are at most two contexts apart.
+        const size_t start = k > EZTEST_TEXT_CONTEXT ? k - EZTEST_TEXT_CONTEXT : 0;
+        size_t end = k;
+        for(size_t equal = 0; end < count && equal <= 2 * EZTEST_TEXT_CONTEXT; end++)
+        {
+            equal = edits[end].type == ' ' ? equal + 1 : 0;
+        }
+        while(end > k && edits[end - 1].type == ' ') end--;
+        end = end + EZTEST_TEXT_CONTEXT < count ? end + EZTEST_TEXT_CONTEXT : count;
+
+        size_t a_len = 0, b_len = 0;
+        for(size_t e = start; e < end; e++)
+        {
+            a_len += edits[e].type != '+';
+            b_len += edits[e].type != '-';
+        }
+        char header[96];
+        // Like diff -u, an empty range starts at the line before it.
+        const int len = snprintf(header, sizeof(header), "\n    @@ -%zu,%zu +%zu,%zu @@",
+                                 edits[start].a + (a_len > 0), a_len, edits[start].b + (b_len > 0), b_len);
+        text_append(&buffer, header, (size_t)len);
+
+        for(size_t e = start; e < end && printed < EZTEST_TEXT_MAX_LINES;)
+        {
+            if(edits[e].type == ' ')
+            {
+                text_append_line(&buffer, ' ', &a[edits[e++].a], NULL, NULL);
+                printed++;
+                continue;
+            }
+            // Pairs the removed and added lines of a change, for the char diff.
+            const size_t del = e;
+            size_t ins = del, ins_end;
+            while(ins < end && edits[ins].type == '-') ins++;
+            for(ins_end = ins; ins_end < end && edits[ins_end].type == '+'; ins_end++);
+            const size_t removed_count = ins - del, added_count = ins_end - ins;
+
+            for(size_t r = 0; r < removed_count && printed < EZTEST_TEXT_MAX_LINES; r++, printed++)
+            {
+                const struct text_line *other = r < added_count ? &b[edits[ins + r].b] : NULL;
+                text_append_line(&buffer, '-', &a[edits[del + r].a], other, removed);
+            }
+            for(size_t r = 0; r < added_count && printed < EZTEST_TEXT_MAX_LINES; r++, printed++)
+            {
+                const struct text_line *other = r < removed_count ? &a[edits[del + r].a] : NULL;
+                text_append_line(&buffer, '+', &b[edits[ins + r].b], other, added);
+            }
+            e = ins_end;
+        }
+        k = end;
+    }
+    if(printed >= EZTEST_TEXT_MAX_LINES)
+    {
+        text_append(&buffer, "\n    ...", 8);
+    }
+
+done:
+    free(a);
+    free(b);
+    free(diff.deleted);
+    free(diff.inserted);
+    free(diff.fd == NULL ? NULL : diff.fd - (ny + 1));
+    free(edits);
+    return buffer.data;
+}
+
+//endregion text diff
+
+//region hash
+
+#define XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3 0x165667B19E3779F9ULL
+#define XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+static inline uint64_t xxh_rotl(const uint64_t x, const int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t xxh_read64(const unsigned char *p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline uint32_t xxh_read32(const unsigned char *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+static inline uint64_t xxh_round(uint64_t acc, const uint64_t input)
+{
+    acc += input * XXH_PRIME64_2;
+    return xxh_rotl(acc, 31) * XXH_PRIME64_1;
+}
+
+static inline uint64_t xxh_merge_round(uint64_t acc, const uint64_t val)
+{
+    acc ^= xxh_round(0, val);
+    return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+/**
+ * Hashes the given bytes with XXH64. The four independent lanes of the main loop are
+ * kept in registers, so large buffers are hashed at several bytes per cycle.
+ *
+ * @return The XXH64 hash of the bytes with the given seed.
+ */
+static uint64_t xxh64(const void *bytes, const size_t size, const uint64_t seed)
+{
+    const unsigned char *p = bytes;
+    const unsigned char *const end = p + size;
+    uint64_t h;
+
+    if(size >= 32)
+    {
+        uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+        uint64_t v2 = seed + XXH_PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - XXH_PRIME64_1;
+        const unsigned char *const limit = end - 32;
+        do
+        {
+            v1 = xxh_round(v1, xxh_read64(p));
+            v2 = xxh_round(v2, xxh_read64(p + 8));
+            v3 = xxh_round(v3, xxh_read64(p + 16));
+            v4 = xxh_round(v4, xxh_read64(p + 24));
+            p += 32;
+        } while(p <= limit);
+
+        h = xxh_rotl(v1, 1) + xxh_rotl(v2, 7) + xxh_rotl(v3, 12) + xxh_rotl(v4, 18);
+        h = xxh_merge_round(h, v1);
+        h = xxh_merge_round(h, v2);
+        h = xxh_merge_round(h, v3);
+        h = xxh_merge_round(h, v4);
+    }
+    else
+    {
+        h = seed + XXH_PRIME64_5;
+    }
+
+    h += (uint64_t)size;
+    for(; end - p >= 8; p += 8)
+    {
+        h ^= xxh_round(0, xxh_read64(p));
+        h  = xxh_rotl(h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+    }
+    if(end - p >= 4)
+    {
+        h ^= (uint64_t)xxh_read32(p) * XXH_PRIME64_1;
+        h  = xxh_rotl(h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        p += 4;
+    }
+    for(; p < end; p++)
+    {
+        h ^= *p * XXH_PRIME64_5;
+        h  = xxh_rotl(h, 11) * XXH_PRIME64_1;
+    }
+
+    h ^= h >> 33;
+    h *= XXH_PRIME64_2;
+    h ^= h >> 29;
+    h *= XXH_PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+//endregion hash
+
+//region asserts
+
+void assert_is_null_failed(const void *value, char *file, const int line)
+{
+    register_fail(file, line, operand_none, "Assert is null failed: value is not null.");
+}
+
+void assert_is_not_null_failed(const void *value, char *file, const int line)
+{
+    register_fail(file, line, operand_none, "Assert is not null failed: value is null.");
+}
+
+void assert_is_true_failed(const bool condition, char *file, const int line)
+{
+    register_fail(file, line, operand_none, "Assert is true failed.");
+}
+
+void assert_is_false_failed(const bool condition, char *file, const int line)
+{
+    register_fail(file, line, operand_none, "Assert is false failed.");
+}
+
+void assert_are_same_failed(const void *expected, const void *actual, char *file, const int line)
+{
+    register_fail(file, line, operand_none, "Assert are same failed: different memory location.");
+}
+
+void assert_are_not_same_failed(const void *unexpected, const void *actual, char *file, const int line)
+{
+    register_fail(file, line, operand_none, "Assert are not same failed: same memory location.");
+}
+
+#ifdef NAN
+
+void assert_is_nan(const float value, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(!isnan(value))
+    {
+        register_fail(file, line, operand_none, "Assert is NaN failed.");
+    }
+}
+
+#endif
+
+/**
+ * Compares two arrays of elements of the given width.
+ *
+ * @param a      The first array.
+ * @param b      The second array.
+ * @param count  The amount of elements in each array.
+ * @param width  The size of each element, 1, 2, 4 or 8.
+ * @param first  Set to the index of the first differing element, or count if the arrays are equal.
+ * @return The amount of differing elements.
+ */
+static size_t array_mismatch(const unsigned char *a, const unsigned char *b, const size_t count,
+                             const size_t width, size_t *first)
+{
+    const size_t size = count * width;
+    size_t mismatches = 0;
+    size_t i = 0;
+    *first = count;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    // One mask bit per byte, set where the bytes differ. The bits of each element are folded
+    // into the bit of its first byte, which leaves one bit per differing element.
+#if defined(__AVX2__)
+    const size_t block = 32;
+#else
+    const size_t block = 16;
+#endif
+    const uint32_t starts = width == 1 ? 0xffffffff : width == 2 ? 0x55555555 : width == 4 ? 0x11111111 : 0x01010101;
+    for(; i + block <= size; i += block)
+    {
+#if defined(__AVX2__)
+        const __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(a + i)),
+                                             _mm256_loadu_si256((const __m256i *)(b + i)));
+        uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(eq);
+#else
+        const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(a + i)),
+                                          _mm_loadu_si128((const __m128i *)(b + i)));
+        uint32_t mask = ~(uint32_t)_mm_movemask_epi8(eq) & 0xffff;
+#endif
+        if(mask == 0) continue;
+
+        for(size_t shift = 1; shift < width; shift <<= 1)
+        {
+            mask |= mask >> shift;
+        }
+        mask &= starts;
+        if(*first == count)
+        {
+            *first = (i + __builtin_ctz(mask)) / width;
+        }
+        mismatches += __builtin_popcount(mask);
+    }
+#else
+    // Skips equal words, differing words are compared element by element below.
+    for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t x, y;
+        memcpy(&x, a + i, sizeof(x));
+        memcpy(&y, b + i, sizeof(y));
+        if(x == y) continue;
+
+        for(size_t j = i; j < i + sizeof(uint64_t); j += width)
+        {
+            if(memcmp(a + j, b + j, width) != 0)
+            {
+                if(*first == count) *first = j / width;
+                mismatches++;
+            }
+        }
+    }
+#endif
+
+    for(; i < size; i += width)
+    {
+        if(memcmp(a + i, b + i, width) != 0)
+        {
+            if(*first == count) *first = i / width;
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * Registers a failed memory assert. When both values are present and differ, the failure
+ * is reported with diff_msg followed by a hexdump of the bytes around the first difference,
+ * otherwise with msg and the leading bytes of each value.
+ *
+ * @param msg      The failure message, formatted with the leading bytes of each value in hex.
+ * @param diff_msg The failure message, formatted with the amount of differing bytes, the size
+ *                 and the offset of the first differing byte. May be @code NULL @endcode.
+ */
+static void mem_test_failed(const void *ptr1, const void *ptr2, const size_t size, char *file,
+                            const int line, const char *msg, const char *diff_msg)
+{
+    if(diff_msg != NULL && ptr1 != NULL && ptr2 != NULL && !options->quiet)
+    {
+        struct array_diff diff = { .count = size, .width = 1, .is_signed = false };
+        diff.mismatches = array_mismatch(ptr1, ptr2, size, 1, &diff.index);
+        if(diff.mismatches > 0)
+        {
+            const size_t row = diff.index - diff.index % EZTEST_HEXDUMP_WIDTH;
+            diff.start  = row > 0 ? row - EZTEST_HEXDUMP_WIDTH : 0;
+            diff.window = size - diff.start < EZTEST_HEXDUMP_ROWS * EZTEST_HEXDUMP_WIDTH ?
+                          size - diff.start : EZTEST_HEXDUMP_ROWS * EZTEST_HEXDUMP_WIDTH;
+            diff.elements[0] = (const unsigned char *)ptr1 + diff.start;
+            diff.elements[1] = (const unsigned char *)ptr2 + diff.start;
+            register_fail(file, line, operand_hexdump, diff_msg, &diff);
+            return;
+        }
+    }
+    register_fail(file, line, operand_mem, msg, ptr1, size, ptr2, size);
+}
+
+void assert_equal_mem(const void *expected, const void *actual, const size_t size, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((expected == NULL && actual != NULL) ||
+       (expected != NULL && actual == NULL) ||
+       (expected != NULL && memcmp(expected, actual, size) != 0))
+    {
+        mem_test_failed(expected, actual, size, file, line, "Assert are equal failed: expected %s, but got %s.",
+                        "Assert are equal failed: %zu of %zu bytes differ, first at offset %zu.");
+    }
+}
+
+void assert_not_equal_mem(const void *unexpected, const void *actual, const size_t size, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((unexpected == NULL && actual == NULL) ||
+       (unexpected != NULL && actual != NULL && memcmp(unexpected, actual, size) == 0))
+    {
+        mem_test_failed(unexpected, actual, size, file, line, "Assert not equal failed: %s is equal to %s.", NULL);
+    }
+}
+
+/**
+ * Replaces the file at the given path with the given bytes. The bytes are written to a
+ * temporary file in the same directory which is then renamed, so the file is never left
+ * partially written.
+ *
+ * @param mode The permissions of the replaced file.
+ * @return @code EZTEST_RESULT_OK @endcode on success; otherwise @code EZTEST_RESULT_ERR @endcode
+ *         with errno set.
+ */
+static int replace_file(const char *path, const void *bytes, const size_t size, const mode_t mode)
+{
+    static const char suffix[] = ".XXXXXX";
+    const size_t path_len = strlen(path);
+    char *tmp = malloc(path_len + sizeof(suffix));
+    if(tmp == NULL)
+    {
+        return EZTEST_RESULT_ERR;
+    }
+    memcpy(tmp, path, path_len);
+    memcpy(tmp + path_len, suffix, sizeof(suffix));
+
+    const int fd = mkstemp(tmp);
+    if(fd == -1)
+    {
+        free(tmp);
+        return EZTEST_RESULT_ERR;
+    }
+
+    int result = fchmod(fd, mode) == 0 ? EZTEST_RESULT_OK : EZTEST_RESULT_ERR;
+    for(size_t written = 0; result == EZTEST_RESULT_OK && written < size;)
+    {
+        const ssize_t n = write(fd, (const unsigned char *)bytes + written, size - written);
+        if(n > 0)
+        {
+            written += (size_t)n;
+        }
+        else if(n == -1 && errno != EINTR)
+        {
+            result = EZTEST_RESULT_ERR;
+        }
+    }
+    if(result == EZTEST_RESULT_OK && fsync(fd) != 0)
+    {
+        result = EZTEST_RESULT_ERR;
+    }
+    const int err = errno;
+    if(close(fd) != 0 && result == EZTEST_RESULT_OK)
+    {
+        result = EZTEST_RESULT_ERR;
+    }
+    if(result == EZTEST_RESULT_OK && rename(tmp, path) != 0)
+    {
+        result = EZTEST_RESULT_ERR;
+    }
+    if(result != EZTEST_RESULT_OK)
+    {
+        unlink(tmp);
+        errno = err;
+    }
+    free(tmp);
+    return result;
+}
+
+void assert_matches_golden(const void *actual, const size_t size, const char *path, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(path == NULL || (actual == NULL && size > 0))
+    {
+        register_fail(file, line, operand_none, "Assert matches golden failed: path or value is NULL.");
+        return;
+    }
+
+    struct stat st;
+    const int fd = open(path, O_RDONLY);
+    if(fd == -1 || fstat(fd, &st) != 0)
+    {
+        const int err = errno;
+        if(fd != -1) close(fd);
+        if(options->update_golden && err == ENOENT)
+        {
+            if(replace_file(path, actual, size, 0644) != EZTEST_RESULT_OK)
+            {
+                register_fail(file, line, operand_str, "Assert matches golden failed: could not write '%s': %s.",
+                              path, strerror(errno));
+            }
+            return;
+        }
+        register_fail(file, line, operand_str, "Assert matches golden failed: could not open '%s': %s.",
+                      path, strerror(err));
+        return;
+    }
+
+    const size_t golden_size = (size_t)st.st_size;
+    const void *golden = NULL;
+    if(golden_size > 0)
+    {
+        golden = mmap(NULL, golden_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(golden == MAP_FAILED)
+        {
+            const int err = errno;
+            close(fd);
+            register_fail(file, line, operand_str, "Assert matches golden failed: could not map '%s': %s.",
+                          path, strerror(err));
+            return;
+        }
+        madvise((void *)golden, golden_size, MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    const size_t common = golden_size < size ? golden_size : size;
+    const bool equal = golden_size == size && (common == 0 || memcmp(golden, actual, common) == 0);
+    if(!equal && options->update_golden)
+    {
+        if(replace_file(path, actual, size, st.st_mode & 07777) != EZTEST_RESULT_OK)
+        {
+            register_fail(file, line, operand_str, "Assert matches golden failed: could not write '%s': %s.",
+                          path, strerror(errno));
+        }
+    }
+    else if(!equal)
+    {
+        if(golden_size != size)
+        {
+            register_fail(file, line, operand_uint, "Assert matches golden failed: expected %ju bytes, but got %ju bytes.",
+                          (uintmax_t)golden_size, (uintmax_t)size);
+        }
+        if(common > 0 && memcmp(golden, actual, common) != 0)
+        {
+            mem_test_failed(golden, actual, common, file, line, "Assert matches golden failed: expected %s, but got %s.",
+                            "Assert matches golden failed: %zu of %zu bytes differ, first at offset %zu.");
+        }
+    }
+
+    if(golden != NULL)
+    {
+        munmap((void *)golden, golden_size);
+    }
+}
+
+typedef unsigned char vec_byte __attribute__((vector_size(16)));
+
+/**
+ * Counts the line breaks of the given bytes.
+ *
+ * @return The amount of '\n' bytes.
+ */
+static size_t count_line_breaks(const unsigned char *bytes, const size_t size)
+{
+    size_t count = 0, i = 0;
+    while(size - i >= sizeof(vec_byte))
+    {
+        // Each byte lane counts at most 255 line breaks before the lanes are added up.
+        const size_t end = size - i > 255 * sizeof(vec_byte) ? i + 255 * sizeof(vec_byte) : size;
+        vec_byte sum = {0};
+        for(; i + sizeof(vec_byte) <= end; i += sizeof(vec_byte))
+        {
+            vec_byte v;
+            memcpy(&v, bytes + i, sizeof(v));
+            sum -= (vec_byte)(v == '\n');
+        }
+        for(size_t j = 0; j < sizeof(vec_byte); j++)
+        {
+            count += sum[j];
+        }
+    }
+    for(; i < size; i++)
+    {
+        count += bytes[i] == '\n';
+    }
+    return count;
+}
+
+/**
+ * Reads from the stream until the buffer is full or the stream ends.
+ *
+ * @param stream A pointer to the file descriptor of the stream.
+ * @return The amount of bytes read, or -1 on error.
+ */
+static ssize_t read_fd_chunk(void *stream, unsigned char *buffer, const size_t size)
+{
+    const int fd = *(const int *)stream;
+    size_t len = 0;
+    while(len < size)
+    {
+        const ssize_t n = read(fd, buffer + len, size - len);
+        if(n == 0)
+        {
+            break;
+        }
+        if(n == -1)
+        {
+            if(errno == EINTR) continue;
+            return -1;
+        }
+        len += (size_t)n;
+    }
+    return (ssize_t)len;
+}
+
+/**
+ * Reads from the stream until the buffer is full or the stream ends.
+ *
+ * @param stream The FILE pointer of the stream.
+ * @return The amount of bytes read, or -1 on error.
+ */
+static ssize_t read_file_chunk(void *stream, unsigned char *buffer, const size_t size)
+{
+    const size_t len = fread(buffer, 1, size, stream);
+    return len < size && ferror(stream) ? -1 : (ssize_t)len;
+}
+
+/**
+ * Compares two streams chunk by chunk until they differ or both end, and registers a failure
+ * if they differ. Only two chunks are held in memory at a time.
+ *
+ * @param read_chunk Reads the next chunk of a stream, see @see read_fd_chunk.
+ * @param streams    The expected and the actual stream, as passed to read_chunk.
+ */
+static void stream_equal(ssize_t (*read_chunk)(void *, unsigned char *, size_t), void *streams[2],
+                         char *file, const int line)
+{
+    static unsigned char chunks[2][EZTEST_STREAM_CHUNK_SIZE];
+    static const char *const names[2] = { "expected", "actual" };
+
+    size_t offset = 0;
+    uintmax_t lines = 1;
+    for(;;)
+    {
+        ssize_t len[2];
+        for(int i = 0; i < 2; i++)
+        {
+            len[i] = read_chunk(streams[i], chunks[i], EZTEST_STREAM_CHUNK_SIZE);
+            if(len[i] == -1)
+            {
+                register_fail(file, line, operand_str, "Assert stream equal failed: could not read the %s stream: %s.",
+                              names[i], strerror(errno));
+                return;
+            }
+        }
+
+        const size_t common = (size_t)(len[0] < len[1] ? len[0] : len[1]);
+        if(memcmp(chunks[0], chunks[1], common) != 0)
+        {
+            struct array_diff diff = { .count = common, .width = 1, .is_signed = false };
+            diff.mismatches = array_mismatch(chunks[0], chunks[1], common, 1, &diff.index);
+
+            const size_t row = diff.index - diff.index % EZTEST_HEXDUMP_WIDTH;
+            const size_t start = row > 0 ? row - EZTEST_HEXDUMP_WIDTH : 0;
+            diff.window = common - start < EZTEST_HEXDUMP_ROWS * EZTEST_HEXDUMP_WIDTH ?
+                          common - start : EZTEST_HEXDUMP_ROWS * EZTEST_HEXDUMP_WIDTH;
+            diff.elements[0] = chunks[0] + start;
+            diff.elements[1] = chunks[1] + start;
+            lines += count_line_breaks(chunks[0], diff.index);
+            diff.start  = offset + start;
+            diff.index += offset;
+            register_fail(file, line, operand_stream, "Assert stream equal failed: the streams differ at offset %zu, on line %ju.",
+                          &diff, lines);
+            return;
+        }
+        if(len[0] != len[1])
+        {
+            lines += count_line_breaks(chunks[0], common);
+            register_fail(file, line, operand_uint, len[0] < len[1] ?
+                          "Assert stream equal failed: the expected stream ends at offset %ju, on line %ju." :
+                          "Assert stream equal failed: the actual stream ends at offset %ju, on line %ju.",
+                          (uintmax_t)(offset + common), lines);
+            return;
+        }
+        if(common < EZTEST_STREAM_CHUNK_SIZE)
+        {
+            return;
+        }
+        lines  += count_line_breaks(chunks[0], common);
+        offset += common;
+    }
+}
+
+void assert_stream_equal_fd(const int expected, const int actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(expected == actual)
+    {
+        return;
+    }
+    int fds[2] = { expected, actual };
+    void *streams[2] = { &fds[0], &fds[1] };
+    stream_equal(read_fd_chunk, streams, file, line);
+}
+
+void assert_stream_equal_file(FILE *expected, FILE *actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(expected == actual)
+    {
+        return;
+    }
+    if(expected == NULL || actual == NULL)
+    {
+        register_fail(file, line, operand_none, "Assert stream equal failed: stream is NULL.");
+        return;
+    }
+    void *streams[2] = { expected, actual };
+    stream_equal(read_file_chunk, streams, file, line);
+}
+
+static void assert_array_equal(const void *expected, const void *actual, const size_t count, const size_t width,
+                               const bool is_signed, char *file, const int line)
+{
+    if(expected == actual)
+    {
+        return;
+    }
+
+    struct array_diff diff = { .count = count, .width = width, .is_signed = is_signed, .elements = {expected, actual} };
+    if(expected == NULL || actual == NULL)
+    {
+        diff.mismatches = count;
+        diff.index = 0;
+    }
+    else
+    {
+        diff.mismatches = array_mismatch(expected, actual, count, width, &diff.index);
+        if(diff.mismatches == 0)
+        {
+            return;
+        }
+    }
+
+    diff.start  = diff.index > EZTEST_ARRAY_CONTEXT ? diff.index - EZTEST_ARRAY_CONTEXT : 0;
+    diff.window = (diff.index + EZTEST_ARRAY_CONTEXT + 1 < count ? diff.index + EZTEST_ARRAY_CONTEXT + 1 : count) - diff.start;
+    for(int i = 0; i < 2; i++)
+    {
+        if(diff.elements[i] != NULL)
+        {
+            diff.elements[i] += diff.start * width;
+        }
+    }
+    register_fail(file, line, operand_array,
+                  "Assert array equal failed: %zu of %zu elements differ, first at index %zu: expected %s, but got %s.",
+                  &diff);
+}
+
+void assert_array_equal_int(const void *expected, const void *actual, const size_t count, const size_t width,
+                            char *file, const int line)
+{
+    eztest_assert_count++;
+    assert_array_equal(expected, actual, count, width, true, file, line);
+}
+
+void assert_array_equal_uint(const void *expected, const void *actual, const size_t count, const size_t width,
+                             char *file, const int line)
+{
+    eztest_assert_count++;
+    assert_array_equal(expected, actual, count, width, false, file, line);
+}
+
+/**
+ * The vector types of the near kernels. The compiler maps them to the vector registers of
+ * the target, or splits them when the target has no vectors this wide.
+ */
+typedef float    vec_flt  __attribute__((vector_size(16)));
+typedef int32_t  mask_flt __attribute__((vector_size(16)));
+typedef uint32_t bits_flt __attribute__((vector_size(16)));
+typedef double   vec_dbl  __attribute__((vector_size(16)));
+typedef int64_t  mask_dbl __attribute__((vector_size(16)));
+typedef uint64_t bits_dbl __attribute__((vector_size(16)));
+
+/**
+ * Maps the bits of a float to an unsigned integer that has the same order as the float.
+ * Negative and positive zero are mapped to the same integer.
+ */
+static inline uint32_t ordered_flt(const float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits & UINT32_C(0x80000000) ? UINT32_C(0x80000000) - (bits & UINT32_C(0x7fffffff))
+                                       : bits | UINT32_C(0x80000000);
+}
+
+/** @see ordered_flt */
+static inline uint64_t ordered_dbl(const double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits & UINT64_C(0x8000000000000000) ? UINT64_C(0x8000000000000000) - (bits & UINT64_C(0x7fffffffffffffff))
+                                               : bits | UINT64_C(0x8000000000000000);
+}
+
+static inline uint32_t ulp_distance_flt(const float a, const float b)
+{
+    const uint32_t x = ordered_flt(a), y = ordered_flt(b);
+    return x > y ? x - y : y - x;
+}
+
+static inline uint64_t ulp_distance_dbl(const double a, const double b)
+{
+    const uint64_t x = ordered_dbl(a), y = ordered_dbl(b);
+    return x > y ? x - y : y - x;
+}
+
+/** The max distance in units in the last place between two floats or doubles that are considered equal. */
+#ifndef EZTEST_MAX_ULPS
+#define EZTEST_MAX_ULPS 4
+#endif
+
+/** Whether the two floats are at most @see EZTEST_MAX_ULPS apart. NaN is not equal to anything. */
+static inline bool almost_equal_flt(const float a, const float b)
+{
+    return a == b || (!isnan(a) && !isnan(b) && ulp_distance_flt(a, b) <= EZTEST_MAX_ULPS);
+}
+
+/** @see almost_equal_flt */
+static inline bool almost_equal_dbl(const double a, const double b)
+{
+    return a == b || (!isnan(a) && !isnan(b) && ulp_distance_dbl(a, b) <= EZTEST_MAX_ULPS);
+}
+
+// The near checks of the vectors, each lane of the result is -1 where the elements are near and 0 (zero) otherwise.
+
+static inline vec_flt abs_flt(const vec_flt x)
+{
+    return (vec_flt)((bits_flt)x & UINT32_C(0x7fffffff));
+}
+
+static inline mask_flt near_abs_flt(const vec_flt e, const vec_flt a, const float tol)
+{
+    return (e == a) | ((e != e) & (a != a)) | (abs_flt(e - a) <= tol);
+}
+
+static inline mask_flt near_rel_flt(const vec_flt e, const vec_flt a, const float tol)
+{
+    const vec_flt d = abs_flt(e - a);
+    return (e == a) | ((e != e) & (a != a)) | (d <= tol * abs_flt(e)) | (d <= tol * abs_flt(a));
+}
+
+static inline mask_flt near_ulp_flt(const vec_flt e, const vec_flt a, const uint32_t ulps)
+{
+    // Same order as ordered_flt, but signed: negative floats are mapped to minus their magnitude.
+    const bits_flt eneg = (bits_flt)((mask_flt)e >> 31), aneg = (bits_flt)((mask_flt)a >> 31);
+    const mask_flt x = (mask_flt)((eneg & (UINT32_C(0x80000000) - (bits_flt)e)) | (~eneg & (bits_flt)e));
+    const mask_flt y = (mask_flt)((aneg & (UINT32_C(0x80000000) - (bits_flt)a)) | (~aneg & (bits_flt)a));
+    const bits_flt m = (bits_flt)(x > y);
+    const bits_flt d = (m & ((bits_flt)x - (bits_flt)y)) | (~m & ((bits_flt)y - (bits_flt)x));
+    return (e == a) | ((e != e) & (a != a)) | ((e == e) & (a == a) & (d <= ulps));
+}
+
+static inline vec_dbl abs_dbl(const vec_dbl x)
+{
+    return (vec_dbl)((bits_dbl)x & UINT64_C(0x7fffffffffffffff));
+}
+
+static inline mask_dbl near_abs_dbl(const vec_dbl e, const vec_dbl a, const double tol)
+{
+    return (e == a) | ((e != e) & (a != a)) | (abs_dbl(e - a) <= tol);
+}
+
+static inline mask_dbl near_rel_dbl(const vec_dbl e, const vec_dbl a, const double tol)
+{
+    const vec_dbl d = abs_dbl(e - a);
+    return (e == a) | ((e != e) & (a != a)) | (d <= tol * abs_dbl(e)) | (d <= tol * abs_dbl(a));
+}
+
+static inline mask_dbl near_ulp_dbl(const vec_dbl e, const vec_dbl a, const uint64_t ulps)
+{
+    const bits_dbl eneg = (bits_dbl)((mask_dbl)e >> 63), aneg = (bits_dbl)((mask_dbl)a >> 63);
+    const mask_dbl x = (mask_dbl)((eneg & (UINT64_C(0x8000000000000000) - (bits_dbl)e)) | (~eneg & (bits_dbl)e));
+    const mask_dbl y = (mask_dbl)((aneg & (UINT64_C(0x8000000000000000) - (bits_dbl)a)) | (~aneg & (bits_dbl)a));
+    const bits_dbl m = (bits_dbl)(x > y);
+    const bits_dbl d = (m & ((bits_dbl)x - (bits_dbl)y)) | (~m & ((bits_dbl)y - (bits_dbl)x));
+    return (e == a) | ((e != e) & (a != a)) | ((e == e) & (a == a) & (d <= ulps));
+}
+
+/**
+ * Counts the elements of the expected and actual arrays for which near is false, one vector at a time.
+ * The last vector is padded with zeros, which are always near. Expects count and far to be in scope.
+ */
+#define EZTEST_COUNT_FAR(vec, mask, expected, actual, near, tolerance)\
+    do\
+    {\
+        const size_t lanes = sizeof(vec) / sizeof((expected)[0]);\
+        mask far_lanes = { 0 };\
+        vec e, a;\
+        size_t i = 0;\
+        for(; i + lanes <= count; i += lanes)\
+        {\
+            memcpy(&e, (expected) + i, sizeof(vec));\
+            memcpy(&a, (actual) + i, sizeof(vec));\
+            far_lanes += near(e, a, tolerance) + 1;\
+        }\
+        if(i < count)\
+        {\
+            memset(&e, 0, sizeof(vec));\
+            memset(&a, 0, sizeof(vec));\
+            memcpy(&e, (expected) + i, (count - i) * sizeof((expected)[0]));\
+            memcpy(&a, (actual) + i, (count - i) * sizeof((expected)[0]));\
+            far_lanes += near(e, a, tolerance) + 1;\
+        }\
+        for(size_t j = 0; j < lanes; j++)\
+        {\
+            far += (size_t)far_lanes[j];\
+        }\
+    } while(0)
+
+/**
+ * Gets the error of the given pair of elements, measured as given by the mode.
+ * Elements that can not be compared, e.g. a number and NaN, have an infinite error.
+ */
+static double near_error(const double e, const double a, const double ulps, const enum eztest_tolerance mode)
+{
+    if(e == a || (isnan(e) && isnan(a))) return 0;
+    if(isnan(e) || isnan(a))             return INFINITY;
+
+    switch(mode)
+    {
+        case EZTEST_TOLERANCE_REL:
+        {
+            const double error = fabs(e - a) / (fabs(e) > fabs(a) ? fabs(e) : fabs(a));
+            return isnan(error) ? INFINITY : error;
+        }
+
+        case EZTEST_TOLERANCE_ULP:
+            return ulps;
+
+        default:
+        {
+            const double error = fabs(e - a);
+            return isnan(error) ? INFINITY : error;
+        }
+    }
+}
+
+/** Gets the failure message format of a near assert with the given mode, see @see format_failure. */
+static const char *near_message(const enum eztest_tolerance mode)
+{
+    switch(mode)
+    {
+        case EZTEST_TOLERANCE_REL:
+            return "Assert array near failed: %zu of %zu elements differ by more than the relative tolerance, "
+                   "worst at index %zu: expected %.*g, but got %.*g (relative error %g).";
+
+        case EZTEST_TOLERANCE_ULP:
+            return "Assert array near failed: %zu of %zu elements differ by more than the ULP tolerance, "
+                   "worst at index %zu: expected %.*g, but got %.*g (%.0f ULP).";
+
+        default:
+            return "Assert array near failed: %zu of %zu elements differ by more than the tolerance, "
+                   "worst at index %zu: expected %.*g, but got %.*g (error %g).";
+    }
+}
+
+void assert_array_near_flt(const float *expected, const float *actual, const size_t count, const double tolerance,
+                           const enum eztest_tolerance mode, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(expected == actual)
+    {
+        return;
+    }
+    if(expected == NULL || actual == NULL)
+    {
+        register_fail(file, line, operand_none, "Assert array near failed: array is NULL.");
+        return;
+    }
+
+    const float tol = (float)tolerance;
+    const uint32_t ulps = tolerance <= 0 ? 0 : tolerance >= UINT32_MAX ? UINT32_MAX : (uint32_t)tolerance;
+    size_t far = 0;
+    switch(mode)
+    {
+        case EZTEST_TOLERANCE_REL: EZTEST_COUNT_FAR(vec_flt, mask_flt, expected, actual, near_rel_flt, tol);  break;
+        case EZTEST_TOLERANCE_ULP: EZTEST_COUNT_FAR(vec_flt, mask_flt, expected, actual, near_ulp_flt, ulps); break;
+        default:                   EZTEST_COUNT_FAR(vec_flt, mask_flt, expected, actual, near_abs_flt, tol);  break;
+    }
+    if(far == 0)
+    {
+        return;
+    }
+
+    struct near_diff diff = { .count = count, .far = far, .error = -1, .width = sizeof(float) };
+    for(size_t i = 0; i < count; i++)
+    {
+        const double error = near_error(expected[i], actual[i], ulp_distance_flt(expected[i], actual[i]), mode);
+        if(error > diff.error)
+        {
+            diff.index = i;
+            diff.error = error;
+        }
+    }
+    diff.expected = expected[diff.index];
+    diff.actual   = actual[diff.index];
+    register_fail(file, line, operand_near, near_message(mode), &diff);
+}
+
+void assert_array_near_dbl(const double *expected, const double *actual, const size_t count, const double tolerance,
+                           const enum eztest_tolerance mode, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(expected == actual)
+    {
+        return;
+    }
+    if(expected == NULL || actual == NULL)
+    {
+        register_fail(file, line, operand_none, "Assert array near failed: array is NULL.");
+        return;
+    }
+
+    const uint64_t ulps = tolerance <= 0 ? 0 : tolerance >= (double)UINT64_MAX ? UINT64_MAX : (uint64_t)tolerance;
+    size_t far = 0;
+    switch(mode)
+    {
+        case EZTEST_TOLERANCE_REL: EZTEST_COUNT_FAR(vec_dbl, mask_dbl, expected, actual, near_rel_dbl, tolerance); break;
+        case EZTEST_TOLERANCE_ULP: EZTEST_COUNT_FAR(vec_dbl, mask_dbl, expected, actual, near_ulp_dbl, ulps);      break;
+        default:                   EZTEST_COUNT_FAR(vec_dbl, mask_dbl, expected, actual, near_abs_dbl, tolerance); break;
+    }
+    if(far == 0)
+    {
+        return;
+    }
+
+    struct near_diff diff = { .count = count, .far = far, .error = -1, .width = sizeof(double) };
+    for(size_t i = 0; i < count; i++)
+    {
+        const double error = near_error(expected[i], actual[i], (double)ulp_distance_dbl(expected[i], actual[i]), mode);
+        if(error > diff.error)
+        {
+            diff.index = i;
+            diff.error = error;
+        }
+    }
+    diff.expected = expected[diff.index];
+    diff.actual   = actual[diff.index];
+    register_fail(file, line, operand_near, near_message(mode), &diff);
+}
+
+
+
+/** A distinct element counted by the same elements assert. */
+struct same_slot
+{
+    /**
+     * The element. Elements of at most 8 bytes that are compared by their bytes are stored
+     * here, other elements are stored as an index into the expected elements followed by
+     * the actual elements.
+     */
+    uint64_t key;
+    /** The low bits of the hash of the element, never 0 (zero). 0 (zero) marks an empty slot. */
+    uint32_t tag;
+    /** The amount of expected copies of the element minus the amount of actual copies. */
+    int32_t count;
+};
+
+/** The elements and the hash table of the same elements assert. */
+struct same_set
+{
+    struct same_slot *slots;
+    size_t mask;
+    const unsigned char *elements[2];
+    size_t count;
+    size_t size;
+    int (*cmp_fn)(const void *ptr1, const void *ptr2);
+    size_t (*hash_fn)(const void *ptr);
+    /** Whether the elements are stored in the slots, see @see same_slot. */
+    bool inline_keys;
+};
+
+static inline const unsigned char *same_element(const struct same_set *set, const size_t index)
+{
+    return index < set->count ? set->elements[0] + index * set->size
+                              : set->elements[1] + (index - set->count) * set->size;
+}
+
+static inline uint64_t same_key(const struct same_set *set, const unsigned char *element)
+{
+    // The common sizes are loaded without a call to memcpy.
+    uint64_t key = 0;
+    switch(set->size)
+    {
+        case 8:  { uint64_t v; memcpy(&v, element, 8); key = v; break; }
+        case 4:  { uint32_t v; memcpy(&v, element, 4); key = v; break; }
+        case 2:  { uint16_t v; memcpy(&v, element, 2); key = v; break; }
+        case 1:  key = *element; break;
+        default: memcpy(&key, element, set->size); break;
+    }
+    return key;
+}
+
+static inline uint64_t same_hash(const struct same_set *set, const unsigned char *element)
+{
+    if(set->inline_keys)
+    {
+        // The final mix of XXH64, enough to spread a key that is hashed whole.
+        uint64_t h = same_key(set, element) * XXH_PRIME64_1;
+        h ^= h >> 29;
+        h *= XXH_PRIME64_3;
+        return h ^ (h >> 32);
+    }
+    // The user hash is spread over all bits, the table index is taken from the high bits.
+    return set->hash_fn == NULL ? xxh64(element, set->size, 0)
+                                : (uint64_t)set->hash_fn(element) * XXH_PRIME64_1;
+}
+
+/**
+ * Finds the slot of the given element.
+ *
+ * @return The slot of the element, or the empty slot where it belongs.
+ */
+
+static inline struct same_slot *same_find(const struct same_set *set, const unsigned char *element, const uint64_t hash)
+{
+    const uint32_t tag = (uint32_t)hash | 1;
+    const uint64_t key = set->inline_keys ? same_key(set, element) : 0;
+    for(size_t i = (size_t)(hash >> 32) & set->mask;; i = (i + 1) & set->mask)
+    {
+        struct same_slot *slot = &set->slots[i];
+        if(slot->tag == 0)
+        {
+            return slot;
+        }
+        if(set->inline_keys)
+        {
+            if(slot->key == key)
+            {
+                return slot;
+            }
+        }
+        else if(slot->tag == tag)
+        {
+            const unsigned char *other = same_element(set, (size_t)slot->key);
+            if(set->cmp_fn == NULL ? memcmp(other, element, set->size) == 0 : set->cmp_fn(other, element) == 0)
+            {
+                return slot;
+            }
+        }
+    }
+}
+
+/**
+ * Counts the elements of one of the arrays. The lookups are pipelined so that a large table
+ * does not wait for memory one element at a time: the home slot of each element is prefetched
+ * two steps before its lookup, and the element referred to by that slot one step before.
+ *
+ * @param which      0 (zero) to add the expected elements, 1 (one) to remove the actual elements.
+ * @param unexpected Incremented for each actual element that is not expected at all.
+ */
+static void same_count(struct same_set *set, const int which, size_t *unexpected)
+{
+    enum { distance = EZTEST_SAME_ELEMENTS_PREFETCH, ring = 2 * EZTEST_SAME_ELEMENTS_PREFETCH };
+    uint64_t hashes[ring];
+    const size_t base = which == 0 ? 0 : set->count;
+    for(size_t i = 0; i < set->count + ring; i++)
+    {
+        // Element j is looked up before its place in the ring is taken by element i.
+        if(i >= ring)
+        {
+            const size_t j = i - ring;
+            const uint64_t hash = hashes[j % ring];
+            struct same_slot *slot = same_find(set, same_element(set, base + j), hash);
+            if(slot->tag != 0)
+            {
+                slot->count += which == 0 ? 1 : -1;
+            }
+            else if(which == 0)
+            {
+                slot->key   = set->inline_keys ? same_key(set, same_element(set, base + j)) : base + j;
+                slot->tag   = (uint32_t)hash | 1;
+                slot->count = 1;
+            }
+            else
+            {
+                (*unexpected)++;
+            }
+        }
+        if(!set->inline_keys && i >= distance && i - distance < set->count)
+        {
+            const uint64_t hash = hashes[(i - distance) % ring];
+            const struct same_slot *slot = &set->slots[(size_t)(hash >> 32) & set->mask];
+            if(slot->tag == ((uint32_t)hash | 1))
+            {
+                __builtin_prefetch(same_element(set, (size_t)slot->key));
+            }
+        }
+        if(i < set->count)
+        {
+            const uint64_t hash = same_hash(set, same_element(set, base + i));
+            hashes[i % ring] = hash;
+            __builtin_prefetch(&set->slots[(size_t)(hash >> 32) & set->mask], 1);
+        }
+    }
+}
+
+/**
+ * Finds the slot of the given entry of @see same_partitioned(set);, in the table of one partition.
+ *
+ * @param entries The entries of the partitions, each is a hash followed by a copy of the element
+ *                when the elements are not stored in the slots.
+ * @param entry   The offset of the entry to find in the entries.
+ * @return The slot of the entry, or the empty slot where it belongs.
+ */
+static inline struct same_slot *same_partition_find(const struct same_set *set, struct same_slot *slots, const size_t mask,
+                                                    const uint32_t tag, const uint64_t *entries, const size_t entry)
+{
+    const uint64_t hash = entries[entry];
+    for(size_t i = (size_t)hash & mask;; i = (i + 1) & mask)
+    {
+        struct same_slot *slot = &slots[i];
+        if(slot->tag != tag)
+        {
+            return slot;
+        }
+        if(set->inline_keys ? slot->key == hash
+                            : entries[slot->key] == hash && memcmp(&entries[slot->key + 1], &entries[entry + 1], set->size) == 0)
+        {
+            return slot;
+        }
+    }
+}
+
+/**
+ * Tells whether the arrays have the same elements when they are compared by their bytes. The
+ * hashes of both arrays are first partitioned by their high bits, so that each partition is
+ * counted in a table that stays in the cache instead of waiting on memory for each element.
+ * When the elements are stored in the slots, see @see same_slot, the mix of
+ * @see same_hash(set, element); is a bijection of the keys and the hashes are counted in place
+ * of the keys. Wider elements are copied next to their hashes, so that the elements of a
+ * partition are compared in the cache as well.
+ *
+ * @return 1 (one) if the arrays have the same elements, 0 (zero) if not and -1 if out of memory
+ *         or if the partitions are too uneven to be counted in the cache.
+ */
+static int same_partitioned(const struct same_set *set)
+{
+    const size_t stride = set->inline_keys ? 1 : 1 + (set->size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    if(set->count > SIZE_MAX / (2 * stride * sizeof(uint64_t)))
+    {
+        return -1;
+    }
+    unsigned int bits = 0;
+    while(bits < 12 && (set->count >> bits) > EZTEST_SAME_ELEMENTS_PARTITION)
+    {
+        bits++;
+    }
+    const size_t partitions = (size_t)1 << bits;
+    const unsigned int shift = 64 - bits;
+
+    // The entries of partition p of array w start at offsets[2 * p + w].
+    struct arena arena = { NULL, NULL };
+    size_t *offsets = arena_alloc(&arena, (2 * partitions + 1) * sizeof(size_t));
+    if(offsets == NULL)
+    {
+        return -1;
+    }
+    memset(offsets, 0, (2 * partitions + 1) * sizeof(size_t));
+    for(size_t i = 0; i < set->count; i++)
+    {
+        const uint64_t hash = same_hash(set, same_element(set, i));
+        offsets[2 * (bits == 0 ? 0 : (size_t)(hash >> shift)) + 1]++;
+    }
+    size_t largest = 0;
+    for(size_t p = 0; p < partitions; p++)
+    {
+        largest = offsets[2 * p + 1] > largest ? offsets[2 * p + 1] : largest;
+    }
+    // Many copies of the same elements end up in one partition, the caller counts them in its table.
+    uint64_t *entries = NULL;
+    if(largest > 2 * (set->count >> bits) + EZTEST_SAME_ELEMENTS_PARTITION ||
+       (entries = arena_alloc(&arena, 2 * set->count * stride * sizeof(uint64_t))) == NULL)
+    {
+        arena_free(&arena);
+        return -1;
+    }
+    for(size_t i = set->count; i < 2 * set->count; i++)
+    {
+        const uint64_t hash = same_hash(set, same_element(set, i));
+        offsets[2 * (bits == 0 ? 0 : (size_t)(hash >> shift)) + 2]++;
+    }
+    for(size_t i = 0; i < 2 * partitions; i++)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+    for(size_t i = 0; i < 2 * set->count; i++)
+    {
+        const unsigned char *element = same_element(set, i);
+        const uint64_t hash = same_hash(set, element);
+        uint64_t *entry = entries + stride * offsets[2 * (bits == 0 ? 0 : (size_t)(hash >> shift)) + (i >= set->count)]++;
+        entry[0] = hash;
+        if(stride > 1)
+        {
+            memcpy(entry + 1, element, set->size);
+        }
+    }
+    // Each offset has been moved to the start of the next range.
+
+    // A sparse table mostly finds the element in its home slot, so that the probing rarely mispredicts.
+    size_t capacity = 16;
+    while(capacity < 4 * largest)
+    {
+        capacity <<= 1;
+    }
+    struct same_slot *slots = arena_alloc(&arena, capacity * sizeof(struct same_slot));
+    if(slots == NULL)
+    {
+        arena_free(&arena);
+        return -1;
+    }
+    // The slots are tagged with their partition, so that the table is not cleared between partitions.
+    memset(slots, 0, capacity * sizeof(struct same_slot));
+
+    int same = 1;
+    for(size_t p = 0; p < partitions && same; p++)
+    {
+        const size_t expected = p == 0 ? 0 : offsets[2 * p - 1];
+        const size_t actual = offsets[2 * p];
+        const size_t n = actual - expected;
+        if(offsets[2 * p + 1] - actual != n)
+        {
+            same = 0;
+            break;
+        }
+        const uint32_t tag = (uint32_t)p + 1;
+        size_t mask = 15;
+        while(mask + 1 < 4 * n)
+        {
+            mask = 2 * mask + 1;
+        }
+
+        // The low bits of the hashes are spread independently of the partition.
+        for(size_t i = 0; i < n; i++)
+        {
+            const size_t entry = stride * (expected + i);
+            struct same_slot *slot = same_partition_find(set, slots, mask, tag, entries, entry);
+            if(slot->tag != tag)
+            {
+                slot->key   = set->inline_keys ? entries[entry] : entry;
+                slot->tag   = tag;
+                slot->count = 0;
+            }
+            slot->count++;
+        }
+        for(size_t i = 0; i < n && same; i++)
+        {
+            struct same_slot *slot = same_partition_find(set, slots, mask, tag, entries, stride * (actual + i));
+            same = slot->tag == tag && slot->count-- > 0;
+        }
+    }
+    arena_free(&arena);
+    return same;
+}
+
+/**
+ * Lists the first missing or unexpected elements, in the order of their array. The counts
+ * of the listed elements are moved towards 0 (zero).
+ *
+ * @param which 0 (zero) to list the missing expected elements, 1 (one) the unexpected actual elements.
+ * @return The new length of the buffer content, as @see format_append.
+ */
+static size_t same_list(struct same_set *set, const int which, char *buffer, const size_t size, size_t len)
+{
+    static const char *const names[2] = { "expected", "actual" };
+    const size_t base = which == 0 ? 0 : set->count;
+    const size_t n = set->size > EZTEST_MAX_PRINTABLE_LEN ? EZTEST_MAX_PRINTABLE_LEN : set->size;
+
+    len = format_append(buffer, size, len, which == 0 ? "\n    missing   :" : "\n    unexpected:");
+    size_t listed = 0;
+    for(size_t i = 0; i < set->count && listed <= EZTEST_SAME_ELEMENTS_LISTED; i++)
+    {
+        const unsigned char *element = same_element(set, base + i);
+        struct same_slot *slot = same_find(set, element, same_hash(set, element));
+        const bool list = which == 0 ? slot->count > 0 : slot->tag == 0 || slot->count < 0;
+        if(!list)
+        {
+            continue;
+        }
+        if(slot->tag != 0)
+        {
+            slot->count += which == 0 ? -1 : 1;
+        }
+        if(listed++ == EZTEST_SAME_ELEMENTS_LISTED)
+        {
+            len = format_append(buffer, size, len, " ...");
+            break;
+        }
+        char bytes[2 * EZTEST_MAX_PRINTABLE_LEN + 8];
+        format_bytes(bytes, element, n, set->size > n);
+        len = format_append(buffer, size, len, "%s %s[%zu] %s", listed > 1 ? "," : "", names[which], i, bytes);
+    }
+    return len;
+}
+
+void assert_same_elements(const void *expected, const void *actual, const size_t count, const size_t size,
+                          int (*cmp_fn)(const void *ptr1, const void *ptr2), size_t (*hash_fn)(const void *ptr),
+                          char *file, const int line)
+{
+    eztest_assert_count++;
+    if(expected == actual || count == 0 || size == 0)
+    {
+        return;
+    }
+    if(expected == NULL || actual == NULL)
+    {
+        register_fail(file, line, operand_none, "Assert same elements failed: array is NULL.");
+        return;
+    }
+    if(cmp_fn == NULL && memcmp(expected, actual, count * size) == 0)
+    {
+        return;
+    }
+    if(count > INT32_MAX)
+    {
+        register_fail(file, line, operand_none, "Assert same elements failed: more than INT32_MAX elements.");
+        return;
+    }
+
+    struct same_set set = {
+        .elements = { expected, actual },
+        .count    = count,
+        .size     = size,
+        .cmp_fn   = cmp_fn,
+        .hash_fn  = hash_fn,
+        .inline_keys = cmp_fn == NULL && size <= sizeof(uint64_t)
+    };
+    // Large arrays compared by their bytes are compared by partitions, the table below lists the failures.
+    if(cmp_fn == NULL && size <= EZTEST_SAME_ELEMENTS_PARTITION_WIDTH && count > EZTEST_SAME_ELEMENTS_PARTITION &&
+       same_partitioned(&set) == 1)
+    {
+        return;
+    }
+
+    size_t capacity = 16;
+    while(capacity < count + count / 2)
+    {
+        capacity <<= 1;
+    }
+    struct arena arena = { NULL, NULL };
+    set.slots = arena_alloc(&arena, capacity * sizeof(struct same_slot));
+    set.mask  = capacity - 1;
+    if(set.slots == NULL)
+    {
+        register_fail(file, line, operand_none, "Assert same elements failed: out of memory.");
+        return;
+    }
+    // Clearing the table up front faults its pages in sequentially, which is cheaper than
+    // faulting them in at random during the lookups.
+    memset(set.slots, 0, capacity * sizeof(struct same_slot));
+
+    size_t missing = 0, unexpected = 0;
+    same_count(&set, 0, &unexpected);
+    same_count(&set, 1, &unexpected);
+    for(size_t i = 0; i < capacity; i++)
+    {
+        if(set.slots[i].count > 0)
+        {
+            missing += (size_t)set.slots[i].count;
+        }
+        else
+        {
+            unexpected += (size_t)-(intmax_t)set.slots[i].count;
+        }
+    }
+
+    if(missing > 0 || unexpected > 0)
+    {
+        char summary[96];
+        snprintf(summary, sizeof(summary), "%zu of %zu elements are missing and %zu are unexpected.",
+                 missing, count, unexpected);
+
+        char report[2 * (EZTEST_SAME_ELEMENTS_LISTED + 1) * (2 * EZTEST_MAX_PRINTABLE_LEN + 48)] = "";
+        if(!options->quiet)
+        {
+            size_t len = 0;
+            if(missing > 0) len = same_list(&set, 0, report, sizeof(report), len);
+            if(unexpected > 0) same_list(&set, 1, report, sizeof(report), len);
+        }
+        register_fail(file, line, operand_str, "Assert same elements failed: %s%s", summary, report);
+    }
+    arena_free(&arena);
+}
 
 void assert_greater_mem(const void *greater, const void *lesser, const size_t size, char *file, const int line)
 {
-    if((greater == NULL && lesser != NULL) ||
-       (greater == NULL && lesser == NULL) ||
-       (greater != NULL && lesser != NULL && memcmp(greater, lesser, size) < 1))
+    eztest_assert_count++;
+    if((greater == NULL && lesser != NULL) ||
+       (greater == NULL && lesser == NULL) ||
+       (greater != NULL && lesser != NULL && memcmp(greater, lesser, size) < 1))
+    {
+        mem_test_failed(greater, lesser, size, file, line, "Assert greater failed: %s is lesser than or equal to %s.",
+                        "Assert greater failed: %zu of %zu bytes differ, first at offset %zu where the first value is lesser.");
+    }
+}
+
+void assert_greater_equal_mem(const void *ge, const void *le, const size_t size, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((ge == NULL && le != NULL) ||
+       (ge != NULL && le != NULL && memcmp(ge, le, size) < 0))
+    {
+        mem_test_failed(ge, le, size, file, line, "Assert greater equal failed: %s is lesser than %s.",
+                        "Assert greater equal failed: %zu of %zu bytes differ, first at offset %zu where the first value is lesser.");
+    }
+}
+
+void assert_less_mem(const void *lesser, const void *greater, const size_t size, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((lesser != NULL && greater == NULL) ||
+       (lesser == NULL && greater == NULL) ||
+       (lesser != NULL && greater != NULL && memcmp(lesser, greater, size) >= 0))
+    {
+        mem_test_failed(lesser, greater, size, file, line, "Assert lesser failed: %s is greater than or equal to %s.",
+                        "Assert lesser failed: %zu of %zu bytes differ, first at offset %zu where the first value is greater.");
+    }
+}
+
+void assert_less_equal_mem(const void *le, const void *ge, const size_t size, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((le != NULL && ge == NULL) ||
+       (le != NULL && ge != NULL && memcmp(le, ge, size) > 0))
+    {
+        mem_test_failed(le, ge, size, file, line, "Assert less or equal failed: %s is greater than %s.",
+                        "Assert less or equal failed: %zu of %zu bytes differ, first at offset %zu where the first value is greater.");
+    }
+}
+
+void assert_are_equal_cmp(const void *expected, 
+                           const void *actual, 
+                           int(*cmp_fn)(const void *ptr1, const void *ptr2),
+                           char *file,
+                           const int line)
+{
+    eztest_assert_count++;
+    if(cmp_fn(expected, actual) != 0)
+    {
+        register_fail(file, line, operand_none, "Assert are equal failed.");
+    }
+}
+
+void assert_are_not_equal_cmp(const void *unexpected, 
+                               const void *actual, 
+                               int(*cmp_fn)(const void *ptr1, const void *ptr2),
+                               char *file,
+                               const int line)
+{
+    eztest_assert_count++;
+    if(cmp_fn(unexpected, actual) == 0)
+    {
+        register_fail(file, line, operand_none, "Assert not equal failed.");
+    }
+}
+
+void assert_greater_cmp(const void *greater,
+                         const void *lesser,
+                         int(*cmp_fn)(const void *ptr1, const void *ptr2),
+                         char *file,
+                         const int line)
+{
+    eztest_assert_count++;
+    if(cmp_fn(greater, lesser) < 1)
+    {
+        register_fail(file, line, operand_none, "Assert greater failed.");
+    }
+}
+
+void assert_greater_equal_cmp(const void *ge, 
+                               const void *le, 
+                               int(*cmp_fn)(const void *ptr1, const void *ptr2),
+                               char *file,
+                               const int line)
+{
+    eztest_assert_count++;
+    if(cmp_fn(ge, le) < 0)
+    {
+        register_fail(file, line, operand_none, "Assert greater or equal failed.");
+    }
+}
+
+void assert_less_cmp(const void *lesser,
+                      const void *greater,
+                      int(*cmp_fn)(const void *ptr1, const void *ptr2),
+                      char *file,
+                      const int line)
+{
+    eztest_assert_count++;
+    if(cmp_fn(lesser, greater) >= 0)
+    {
+        register_fail(file, line, operand_none, "Assert less failed.");
+    }
+}
+
+
+void assert_less_equal_cmp(const void *le,
+                            const void *ge,
+                            int(*cmp_fn)(const void *ptr1, const void *ptr2),
+                            char *file,
+                            const int line)
+{
+    eztest_assert_count++;
+    if(cmp_fn(le, ge) > 0)
+    {
+        register_fail(file, line, operand_none, "Assert less or equal failed.");
+    }
+}
+
+void assert_are_equal_ch_failed(const char expected, const char actual, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert are equal failed: expected '%c', but got '%c'.", (intmax_t)expected, (intmax_t)actual);
+}
+
+void assert_are_equal_sch_failed(const signed char expected, const signed char actual, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert are equal failed: expected '%c', but got '%c'.", (intmax_t)expected, (intmax_t)actual);
+}
+
+void assert_are_equal_uch_failed(const unsigned char expected, const unsigned char actual, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert are equal failed: expected '%c', but got '%c'.", (intmax_t)expected, (intmax_t)actual);
+}
+
+void assert_are_equal_int_failed(const intmax_t expected, const intmax_t actual, char *file, const int line)
+{
+    register_fail(file, line, operand_int, "Assert are equal failed: expected '%ld', but got '%ld'.", expected, actual);
+}
+
+void assert_are_equal_uint_failed(const uintmax_t expected, const uintmax_t actual, char *file, const int line)
+{
+    register_fail(file, line, operand_uint, "Assert are equal failed: expected '%ld', but got '%ld'.", expected, actual);
+}
+
+/**
+ * Tests whether two long doubles are equal, i.e. at most LDBL_EPSILON apart. The tolerance is
+ * absolute, not in units in the last place like for floats and doubles: long doubles of
+ * magnitude 2 or more must be exactly equal, long doubles near 0 (zero) are equal to all values
+ * within LDBL_EPSILON. An assert with a NaN operand passes.
+ *
+ * @param expected The first and expected value.
+ * @param actual   The actual value generated by the code under test.
+ *
+ * @remarks Use assert_are_equal_precision() to compare with an application specific tolerance.
+ */
+void assert_are_equal_ldbl(const long double expected, const long double actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(fabsl(expected - actual) > LDBL_EPSILON)
+    {
+        register_fail(file, line, operand_ldbl, "Assert are equal failed: expected '%0.8Lf', but got '%0.8Lf'.", expected, actual);
+    }
+}
+
+/** Tests whether the two floats are equal, i.e. at most EZTEST_MAX_ULPS apart. */
+void assert_are_equal_flt(const float expected, const float actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(!almost_equal_flt(expected, actual))
+    {
+        register_fail(file, line, operand_dbl, "Assert are equal failed: expected '%.9g' (%a), but got '%.9g' (%a).", (double)expected, (double)actual);
+    }
+}
+
+/** Tests whether the two doubles are equal, i.e. at most EZTEST_MAX_ULPS apart. */
+void assert_are_equal_dbl(const double expected, const double actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(!almost_equal_dbl(expected, actual))
+    {
+        register_fail(file, line, operand_dbl, "Assert are equal failed: expected '%.17g' (%a), but got '%.17g' (%a).", (double)expected, (double)actual);
+    }
+}
+
+/** The vector types of the bulk kernels. */
+typedef int8_t   bulk_i8  __attribute__((vector_size(16)));
+typedef uint8_t  bulk_u8  __attribute__((vector_size(16)));
+typedef int16_t  bulk_i16 __attribute__((vector_size(16)));
+typedef uint16_t bulk_u16 __attribute__((vector_size(16)));
+typedef int32_t  bulk_i32 __attribute__((vector_size(16)));
+typedef uint32_t bulk_u32 __attribute__((vector_size(16)));
+typedef int64_t  bulk_i64 __attribute__((vector_size(16)));
+typedef uint64_t bulk_u64 __attribute__((vector_size(16)));
+typedef float    bulk_flt __attribute__((vector_size(16)));
+typedef double   bulk_dbl __attribute__((vector_size(16)));
+
+/** A failing array of a bulk assert, the values are stored in the member matching the element type. */
+struct bulk_report
+{
+    /** The amount of failing elements. */
+    size_t bad;
+    /** The index of the first failing element. */
+    size_t index;
+    /** Whether any element is ordered, NaN is not. When false min and max are not set. */
+    bool ordered;
+    union bulk_value
+    {
+        intmax_t  i;
+        uintmax_t u;
+        double    d;
+    } value, previous, min, max;
+};
+
+/** @return Whether no lane of the given mask is set. */
+static inline bool bulk_none(const void *mask, const size_t size)
+{
+    uint64_t lanes[2] = { 0 };
+    memcpy(lanes, mask, size);
+    return (lanes[0] | lanes[1]) == 0;
+}
+
+/**
+ * Defines the kernels of one element type. The check tests a whole array a vector at a time
+ * and only tells whether all elements pass. The scan is run when the check fails, it finds
+ * the failing elements with the exact bounds.
+ *
+ * @param suffix The suffix of the kernel names.
+ * @param type   The element type.
+ * @param vec    The vector type of the element type.
+ * @param mask   The vector type of comparisons of vec, of signed integers as wide as the elements.
+ * @param bound  The type of the exact bounds.
+ * @param member The member of union bulk_value to store the values in.
+ */
+#define EZTEST_BULK_KERNELS(suffix, type, vec, mask, bound, member)                                  \
+static bool bulk_check_##suffix(const type *values, const size_t count,                              \
+                                const enum eztest_predicate predicate, const type lo, const type hi) \
+{                                                                                                    \
+    enum { lanes = sizeof(vec) / sizeof(type) };                                                     \
+    mask bad = { 0 };                                                                                \
+    size_t i = 0;                                                                                    \
+    switch(predicate)                                                                                \
+    {                                                                                                \
+        case EZTEST_ALL_IN_RANGE:                                                                    \
+        case EZTEST_ALL_EQUAL_VALUE:                                                                 \
+            for(; i + lanes <= count; i += lanes)                                                    \
+            {                                                                                        \
+                vec v;                                                                               \
+                memcpy(&v, values + i, sizeof(v));                                                   \
+                bad |= ~((v >= lo) & (v <= hi));                                                     \
+            }                                                                                        \
+            for(; i < count; i++)                                                                    \
+            {                                                                                        \
+                if(!(values[i] >= lo && values[i] <= hi)) return false;                              \
+            }                                                                                        \
+            break;                                                                                   \
+                                                                                                     \
+        case EZTEST_SORTED:                                                                          \
+            for(; i + lanes < count; i += lanes)                                                     \
+            {                                                                                        \
+                vec v, next;                                                                         \
+                memcpy(&v, values + i, sizeof(v));                                                   \
+                memcpy(&next, values + i + 1, sizeof(next));                                         \
+                bad |= ~(v <= next);                                                                 \
+            }                                                                                        \
+            for(; i + 1 < count; i++)                                                                \
+            {                                                                                        \
+                if(!(values[i] <= values[i + 1])) return false;                                      \
+            }                                                                                        \
+            /* A single NaN is not compared to anything, it is checked here. */                      \
+            if(count == 1 && values[0] != values[0]) return false;                                   \
+            break;                                                                                   \
+                                                                                                     \
+        case EZTEST_ALL_FINITE:                                                                      \
+            /* v - v is 0 (zero) for finite values and NaN for infinities and NaN. */                \
+            for(; i + lanes <= count; i += lanes)                                                    \
+            {                                                                                        \
+                vec v;                                                                               \
+                memcpy(&v, values + i, sizeof(v));                                                   \
+                v -= v;                                                                              \
+                bad |= v != v;                                                                       \
+            }                                                                                        \
+            for(; i < count; i++)                                                                    \
+            {                                                                                        \
+                const type zero = values[i] - values[i];                                             \
+                if(zero != zero) return false;                                                       \
+            }                                                                                        \
+            break;                                                                                   \
+    }                                                                                                \
+    return bulk_none(&bad, sizeof(bad));                                                             \
+}                                                                                                    \
+                                                                                                     \
+static void bulk_scan_##suffix(const type *values, const size_t count,                               \
+                               const enum eztest_predicate predicate, const bound lo, const bound hi,\
+                               struct bulk_report *report)                                           \
+{                                                                                                    \
+    type min = 0, max = 0;                                                                           \
+    for(size_t i = 0; i < count; i++)                                                                \
+    {                                                                                                \
+        const type v = values[i];                                                                    \
+        bool bad;                                                                                    \
+        switch(predicate)                                                                            \
+        {                                                                                            \
+            case EZTEST_SORTED:                                                                      \
+                bad = (i > 0 && !(values[i - 1] <= v)) || v != v;                                    \
+                break;                                                                               \
+            case EZTEST_ALL_FINITE:                                                                  \
+                bad = v - v != v - v;                                                                \
+                break;                                                                               \
+            default:                                                                                 \
+                bad = !(v >= lo && v <= hi);                                                         \
+                break;                                                                               \
+        }                                                                                            \
+        if(bad && report->bad++ == 0)                                                                \
+        {                                                                                            \
+            report->index = i;                                                                       \
+            report->value.member = v;                                                                \
+            report->previous.member = i > 0 ? values[i - 1] : v;                                     \
+        }                                                                                            \
+        if(v == v && v - v == v - v)                                                                 \
+        {                                                                                            \
+            if(!report->ordered || v < min) min = v;                                                 \
+            if(!report->ordered || v > max) max = v;                                                 \
+            report->ordered = true;                                                                  \
+        }                                                                                            \
+    }                                                                                                \
+    report->min.member = min;                                                                        \
+    report->max.member = max;                                                                        \
+}
+
+EZTEST_BULK_KERNELS(i8,  int8_t,   bulk_i8,  bulk_i8,  intmax_t,  i)
+EZTEST_BULK_KERNELS(u8,  uint8_t,  bulk_u8,  bulk_i8,  uintmax_t, u)
+EZTEST_BULK_KERNELS(i16, int16_t,  bulk_i16, bulk_i16, intmax_t,  i)
+EZTEST_BULK_KERNELS(u16, uint16_t, bulk_u16, bulk_i16, uintmax_t, u)
+EZTEST_BULK_KERNELS(i32, int32_t,  bulk_i32, bulk_i32, intmax_t,  i)
+EZTEST_BULK_KERNELS(u32, uint32_t, bulk_u32, bulk_i32, uintmax_t, u)
+EZTEST_BULK_KERNELS(i64, int64_t,  bulk_i64, bulk_i64, intmax_t,  i)
+EZTEST_BULK_KERNELS(u64, uint64_t, bulk_u64, bulk_i64, uintmax_t, u)
+EZTEST_BULK_KERNELS(flt, float,    bulk_flt, bulk_i32, double,    d)
+EZTEST_BULK_KERNELS(dbl, double,   bulk_dbl, bulk_i64, double,    d)
+
+/**
+ * Formats a value of a bulk assert.
+ *
+ * @param fmt The printf format of the value, ending in d for intmax_t, u for uintmax_t and
+ *            any other conversion for double.
+ */
+static void bulk_format(char *buffer, const size_t size, const char *fmt, const union bulk_value value)
+{
+    switch(fmt[strlen(fmt) - 1])
+    {
+        case 'd':
+            snprintf(buffer, size, fmt, value.i);
+            break;
+        case 'u':
+            snprintf(buffer, size, fmt, value.u);
+            break;
+        default:
+            snprintf(buffer, size, fmt, value.d);
+            break;
+    }
+}
+
+/**
+ * Registers a failed bulk assert.
+ *
+ * @param fmt The printf format of the element values, @see bulk_format.
+ */
+static void bulk_failed(const struct bulk_report *report, const size_t count, const enum eztest_predicate predicate,
+                        const union bulk_value lo, const union bulk_value hi, const char *fmt, char *file,
+                        const int line)
+{
+    char value[64], previous[64], low[64], high[64];
+    bulk_format(value,    sizeof(value),    fmt, report->value);
+    bulk_format(previous, sizeof(previous), fmt, report->previous);
+    bulk_format(low,      sizeof(low),      fmt, lo);
+    bulk_format(high,     sizeof(high),     fmt, hi);
+
+    char summary[320];
+    size_t len = format_append(summary, sizeof(summary), 0, "%zu of %zu elements ", report->bad, count);
+    switch(predicate)
+    {
+        case EZTEST_ALL_IN_RANGE:
+            len = format_append(summary, sizeof(summary), len, "are outside [%s, %s], first at index %zu: %s.",
+                                low, high, report->index, value);
+            break;
+        case EZTEST_ALL_EQUAL_VALUE:
+            len = format_append(summary, sizeof(summary), len, "are not equal to %s, first at index %zu: %s.",
+                                low, report->index, value);
+            break;
+        case EZTEST_SORTED:
+            len = format_append(summary, sizeof(summary), len, "are out of order, first at index %zu: %s after %s.",
+                                report->index, value, previous);
+            break;
+        case EZTEST_ALL_FINITE:
+            len = format_append(summary, sizeof(summary), len, "are not finite, first at index %zu: %s.",
+                                report->index, value);
+            break;
+    }
+    if(report->ordered)
+    {
+        bulk_format(low,  sizeof(low),  fmt, report->min);
+        bulk_format(high, sizeof(high), fmt, report->max);
+        format_append(summary, sizeof(summary), len, " Min %s, max %s.", low, high);
+    }
+
+    static const char *const messages[] = {
+        [EZTEST_ALL_IN_RANGE]    = "Assert all in range failed: %s%s",
+        [EZTEST_ALL_EQUAL_VALUE] = "Assert all equal value failed: %s%s",
+        [EZTEST_SORTED]          = "Assert sorted failed: %s%s",
+        [EZTEST_ALL_FINITE]      = "Assert all finite failed: %s%s"
+    };
+    register_fail(file, line, operand_str, messages[predicate], summary, "");
+}
+
+/**
+ * Narrows the bounds of a bulk assert to the range of the element type.
+ *
+ * @return True if an element of the type can satisfy the bounds; otherwise false.
+ */
+static bool bulk_narrow_int(intmax_t *lo, intmax_t *hi, const intmax_t min, const intmax_t max)
+{
+    if(*lo > *hi || *lo > max || *hi < min)
+    {
+        return false;
+    }
+    *lo = *lo < min ? min : *lo;
+    *hi = *hi > max ? max : *hi;
+    return true;
+}
+
+/** @see bulk_narrow_int(lo, hi, min, max); */
+static bool bulk_narrow_uint(uintmax_t *lo, uintmax_t *hi, const uintmax_t max)
+{
+    if(*lo > *hi || *lo > max)
+    {
+        return false;
+    }
+    *hi = *hi > max ? max : *hi;
+    return true;
+}
+
+/**
+ * Tests an array with the kernels of the given suffix and registers a failure when any element
+ * fails. The check is done with the narrowed bounds, and is skipped when no element can satisfy
+ * them. The scan uses the exact bounds.
+ */
+#define EZTEST_BULK_ASSERT(suffix, type, narrowed, lo, hi, exact_lo, exact_hi, member, fmt)             \
+    do                                                                                                  \
+    {                                                                                                   \
+        if(!(narrowed) || !bulk_check_##suffix(values, count, predicate, (type)(lo), (type)(hi)))        \
+        {                                                                                               \
+            struct bulk_report report = { 0 };                                                          \
+            bulk_scan_##suffix(values, count, predicate, exact_lo, exact_hi, &report);                  \
+            if(report.bad > 0)                                                                          \
+            {                                                                                           \
+                bulk_failed(&report, count, predicate, (union bulk_value){ .member = exact_lo },        \
+                            (union bulk_value){ .member = exact_hi }, fmt, file, line);                 \
+            }                                                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+    while(0)
+
+/**
+ * Registers the failure of a bulk assert of a NULL array.
+ *
+ * @return True if the array is NULL and not empty; otherwise false.
+ */
+static bool bulk_null(const void *values, const size_t count, char *file, const int line)
+{
+    if(values == NULL && count > 0)
+    {
+        register_fail(file, line, operand_str, "Assert all failed: %s%s", "the array is NULL.", "");
+        return true;
+    }
+    return false;
+}
+
+void assert_all_int(const void *values, const size_t count, const size_t width, const enum eztest_predicate predicate,
+                    const intmax_t lo, const intmax_t hi, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(bulk_null(values, count, file, line))
+    {
+        return;
+    }
+
+    intmax_t nlo = lo, nhi = hi;
+    bool narrowed;
+    switch(width)
+    {
+        case sizeof(int8_t):
+            narrowed = bulk_narrow_int(&nlo, &nhi, INT8_MIN, INT8_MAX);
+            EZTEST_BULK_ASSERT(i8, int8_t, narrowed, nlo, nhi, lo, hi, i, "%jd");
+            break;
+        case sizeof(int16_t):
+            narrowed = bulk_narrow_int(&nlo, &nhi, INT16_MIN, INT16_MAX);
+            EZTEST_BULK_ASSERT(i16, int16_t, narrowed, nlo, nhi, lo, hi, i, "%jd");
+            break;
+        case sizeof(int32_t):
+            narrowed = bulk_narrow_int(&nlo, &nhi, INT32_MIN, INT32_MAX);
+            EZTEST_BULK_ASSERT(i32, int32_t, narrowed, nlo, nhi, lo, hi, i, "%jd");
+            break;
+        default:
+            narrowed = bulk_narrow_int(&nlo, &nhi, INT64_MIN, INT64_MAX);
+            EZTEST_BULK_ASSERT(i64, int64_t, narrowed, nlo, nhi, lo, hi, i, "%jd");
+            break;
+    }
+}
+
+void assert_all_uint(const void *values, const size_t count, const size_t width, const enum eztest_predicate predicate,
+                     const uintmax_t lo, const uintmax_t hi, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(bulk_null(values, count, file, line))
+    {
+        return;
+    }
+
+    uintmax_t nlo = lo, nhi = hi;
+    bool narrowed;
+    switch(width)
+    {
+        case sizeof(uint8_t):
+            narrowed = bulk_narrow_uint(&nlo, &nhi, UINT8_MAX);
+            EZTEST_BULK_ASSERT(u8, uint8_t, narrowed, nlo, nhi, lo, hi, u, "%ju");
+            break;
+        case sizeof(uint16_t):
+            narrowed = bulk_narrow_uint(&nlo, &nhi, UINT16_MAX);
+            EZTEST_BULK_ASSERT(u16, uint16_t, narrowed, nlo, nhi, lo, hi, u, "%ju");
+            break;
+        case sizeof(uint32_t):
+            narrowed = bulk_narrow_uint(&nlo, &nhi, UINT32_MAX);
+            EZTEST_BULK_ASSERT(u32, uint32_t, narrowed, nlo, nhi, lo, hi, u, "%ju");
+            break;
+        default:
+            narrowed = bulk_narrow_uint(&nlo, &nhi, UINT64_MAX);
+            EZTEST_BULK_ASSERT(u64, uint64_t, narrowed, nlo, nhi, lo, hi, u, "%ju");
+            break;
+    }
+}
+
+void assert_all_flt(const void *values, const size_t count, __attribute__((unused)) const size_t width,
+                    const enum eztest_predicate predicate, const double lo, const double hi, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(bulk_null(values, count, file, line))
+    {
+        return;
+    }
+
+    // The bounds are rounded to float like a float literal, so that 0.1 matches 0.1f.
+    const double flo = (float)lo, fhi = (float)hi;
+    EZTEST_BULK_ASSERT(flt, float, true, flo, fhi, flo, fhi, d, "%.9g");
+}
+
+void assert_all_dbl(const void *values, const size_t count, __attribute__((unused)) const size_t width,
+                    const enum eztest_predicate predicate, const double lo, const double hi, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(bulk_null(values, count, file, line))
+    {
+        return;
+    }
+
+    EZTEST_BULK_ASSERT(dbl, double, true, lo, hi, lo, hi, d, "%.17g");
+}
+
+void assert_text_equal(const char *expected, const char *actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(expected == actual || (expected != NULL && actual != NULL && strcmp(expected, actual) == 0))
+    {
+        return;
+    }
+    if(expected == NULL || actual == NULL)
+    {
+        register_fail(file, line, operand_str, "Assert text equal failed: expected '%s', but got '%s'.",
+                      expected == NULL ? "NULL" : "text", actual == NULL ? "NULL" : "text");
+        return;
+    }
+
+    char summary[128] = "";
+    char *diff = options->quiet ? NULL : text_diff(expected, actual, summary, sizeof(summary));
+    register_fail(file, line, operand_str, "Assert text equal failed: %s.%s", summary, diff == NULL ? "" : diff);
+    free(diff);
+}
+
+void assert_are_equal_str(const char *expected, const char *actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((expected == NULL && actual != NULL) ||
+       (expected != NULL && actual == NULL) ||
+       (expected != NULL && strcmp(expected, actual) != 0))
+    {
+        register_fail(file, line, operand_str, "Assert are equal failed: expected '%s', but got '%s'.", expected, actual);
+    }
+}
+
+void assert_are_equal_wstr(const wchar_t *expected, const wchar_t *actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((expected == NULL && actual != NULL) ||
+       (expected != NULL && actual == NULL) ||
+       (expected != NULL && wcscmp(expected, actual) != 0))
+    {
+        register_fail(file, line, operand_wstr, "Assert are equal failed: expected '%ls', but got '%ls'.", expected, actual);
+    }
+}
+
+/** Triggered when attempting to compare using an unsupported data type. */
+void assert_are_equal(const void *expected, const void *actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    register_fail(file, line, operand_none, "Assert are equal failed: unsupported data type.");
+}
+
+void assert_are_not_equal_ch_failed(const char unexpected, const char actual, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert not equal failed: '%c' and '%c' are equal.", (intmax_t)unexpected, (intmax_t)actual);
+}
+
+void assert_are_not_equal_sch_failed(const signed char unexpected, const signed char actual, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert not equal failed: '%c' and '%c' are equal.", (intmax_t)unexpected, (intmax_t)actual);
+}
+
+void assert_are_not_equal_uch_failed(const unsigned char unexpected, const unsigned char actual, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert not equal failed: '%c' and '%c' are equal.", (intmax_t)unexpected, (intmax_t)actual);
+}
+
+void assert_are_not_equal_int_failed(const intmax_t unexpected, const intmax_t actual, char *file, const int line)
+{
+    register_fail(file, line, operand_int, "Assert not equal failed: '%ld' and '%ld' are equal.", unexpected, actual);
+}
+
+void assert_are_not_equal_uint_failed(const uintmax_t unexpected, const uintmax_t actual, char *file, const int line)
+{
+    register_fail(file, line, operand_uint, "Assert not equal failed: '%ld' and '%ld' are equal.", unexpected, actual);
+}
+
+/**
+ * Tests whether two long doubles are more than LDBL_EPSILON apart, the opposite of
+ * assert_are_equal_ldbl(). An assert with a NaN operand passes.
+ *
+ * @param unexpected The first and unexpected value.
+ * @param actual     The actual value generated by the code under test.
+ *
+ * @remarks Use assert_are_not_equal_precision() to compare with an application specific tolerance.
+ */
+void assert_are_not_equal_ldbl(const long double unexpected, const long double actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(fabsl(unexpected - actual) <= LDBL_EPSILON)
+    {
+        register_fail(file, line, operand_ldbl, "Assert not equal failed: '%0.8Lf' and '%0.8Lf' are equal.", unexpected, actual);
+    }
+}
+
+/** Tests whether the two floats are more than EZTEST_MAX_ULPS apart. */
+void assert_are_not_equal_flt(const float unexpected, const float actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(almost_equal_flt(unexpected, actual))
+    {
+        register_fail(file, line, operand_dbl, "Assert not equal failed: '%.9g' (%a) and '%.9g' (%a) are equal.", (double)unexpected, (double)actual);
+    }
+}
+
+/** Tests whether the two doubles are more than EZTEST_MAX_ULPS apart. */
+void assert_are_not_equal_dbl(const double unexpected, const double actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(almost_equal_dbl(unexpected, actual))
+    {
+        register_fail(file, line, operand_dbl, "Assert not equal failed: '%.17g' (%a) and '%.17g' (%a) are equal.", (double)unexpected, (double)actual);
+    }
+}
+
+void assert_are_not_equal_str(const char *unexpected, const char *actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((unexpected == NULL && actual == NULL) ||
+       (unexpected != NULL && actual != NULL && strcmp(unexpected, actual) == 0))
+    {
+        register_fail(file, line, operand_str, "Assert not equal failed: '%s' and '%s' are equal.", unexpected, actual);
+    }
+}
+
+void assert_are_not_equal_wstr(const wchar_t *unexpected, const wchar_t *actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((unexpected == NULL && actual == NULL) ||
+       (unexpected != NULL && actual != NULL && wcscmp(unexpected, actual) == 0))
+    {
+        register_fail(file, line, operand_wstr, "Assert not equal failed: '%ls' and '%ls' are equal.", unexpected, actual);
+    }
+}
+
+/** Triggered when attempting to compare using an unsupported data type. */
+void assert_are_not_equal(const void *expected, const void *actual, char *file, const int line)
+{
+    eztest_assert_count++;
+    register_fail(file, line, operand_none, "Assert not equal failed: unsupported data type.");
+}
+
+void assert_are_equal_precision(const long double  expected,
+                                 const long double  actual,
+                                 const long double  epsilon,
+                                 char              *file,
+                                 const int          line)
+{
+    eztest_assert_count++;
+    if(fabsl(expected - actual) > epsilon)
+    {
+        register_fail(file, line, operand_ldbl, "Assert are equal failed: expected '%0.8Lf', but got '%0.8Lf'.", expected, actual);
+    }
+}
+
+void assert_are_not_equal_precision(const long double  unexpected,
+                                     const long double  actual,
+                                     const long double  epsilon,
+                                     char              *file,
+                                     const int          line)
+{
+    eztest_assert_count++;
+    if(fabsl(unexpected - actual) <= epsilon)
+    {
+        register_fail(file, line, operand_ldbl, "Assert not equal failed: '%0.8Lf' and '%0.8Lf' are equal.", unexpected, actual);
+    }
+}
+
+void assert_greater_ch_failed(const char greater, const char lesser, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert greater failed: '%c' is not greater than '%c'.", (intmax_t)greater, (intmax_t)lesser);
+}
+
+void assert_greater_sch_failed(const signed char greater, const signed char lesser, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert greater failed: '%c' is not greater than '%c'.", (intmax_t)greater, (intmax_t)lesser);
+}
+
+void assert_greater_uch_failed(const unsigned char greater, const unsigned char lesser, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert greater failed: '%c' is not greater than '%c'.", (intmax_t)greater, (intmax_t)lesser);
+}
+
+void assert_greater_int_failed(const intmax_t greater, const intmax_t lesser, char *file, const int line)
+{
+    register_fail(file, line, operand_int, "Assert greater failed: '%ld' is not greater than '%ld'.", greater, lesser);
+}
+
+void assert_greater_uint_failed(const uintmax_t greater, const uintmax_t lesser, char *file, const int line)
+{
+    register_fail(file, line, operand_uint, "Assert greater failed: '%ld' is not greater than '%ld'.", greater, lesser);
+}
+
+/**
+ * Tests whether the first long double is greater than, and more than LDBL_EPSILON apart from,
+ * the second. The tolerance is absolute, see assert_are_equal_ldbl(). An assert with a NaN
+ * operand passes.
+ *
+ * @param greater The value that is expected to be greater.
+ * @param lesser  The value that is expected to be lesser.
+ *
+ * @remarks Use assert_greater_precision() to compare with an application specific tolerance.
+ */
+void assert_greater_ldbl(const long double greater, const long double lesser, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(fabsl(greater - lesser) <= LDBL_EPSILON || greater < lesser)
+    {
+        register_fail(file, line, operand_ldbl, "Assert greater failed: '%0.8Lf' is not greater than '%0.8Lf'.", greater, lesser);
+    }
+}
+
+/** Tests whether the first float is greater than, and more than EZTEST_MAX_ULPS apart from, the second. */
+void assert_greater_flt(const float greater, const float lesser, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(!(greater > lesser) || almost_equal_flt(greater, lesser))
+    {
+        register_fail(file, line, operand_dbl, "Assert greater failed: '%.9g' (%a) is not greater than '%.9g' (%a).", (double)greater, (double)lesser);
+    }
+}
+
+/** Tests whether the first double is greater than, and more than EZTEST_MAX_ULPS apart from, the second. */
+void assert_greater_dbl(const double greater, const double lesser, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(!(greater > lesser) || almost_equal_dbl(greater, lesser))
+    {
+        register_fail(file, line, operand_dbl, "Assert greater failed: '%.17g' (%a) is not greater than '%.17g' (%a).", (double)greater, (double)lesser);
+    }
+}
+void assert_greater_str(const char *greater, const char *lesser, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((greater == NULL && lesser != NULL) ||
+       (greater == NULL && lesser == NULL) ||
+       (greater != NULL && lesser != NULL && strcmp(greater, lesser) <= 0))
+    {
+        register_fail(file, line, operand_str, "Assert greater failed: '%s' is not greater than '%s'.", greater, lesser);
+    }
+}
+
+void assert_greater_wstr(const wchar_t *greater, const wchar_t *lesser, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((greater == NULL && lesser != NULL) ||
+       (greater == NULL && lesser == NULL) ||
+       (greater != NULL && lesser != NULL && wcscmp(greater, lesser) <= 0))
+    {
+        register_fail(file, line, operand_wstr, "Assert greater failed: '%ls' is not greater than '%ls'.", greater, lesser);
+    }
+}
+
+/** Triggered when attempting to compare using an unsupported data type. */
+void assert_greater(const void *greater, const void *lesser, char *file, const int line)
+{
+    eztest_assert_count++;
+    register_fail(file, line, operand_none, "Assert greater failed: unsupported data type.");
+}
+
+void assert_greater_precision(const long double   greater,
+                               const long double   lesser,
+                               const long double   epsilon,
+                               char              * file,
+                               const int           line)
+{
+    eztest_assert_count++;
+    if(fabsl(greater - lesser) <= epsilon || greater < lesser)
+    {
+        register_fail(file, line, operand_ldbl, "Assert greater failed: '%0.8Lf' is not greater than '%0.8Lf'.", greater, lesser);
+    }
+}
+
+void assert_greater_equal_ch_failed(const char ge, const char le, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert greater or equal failed: '%c' is lesser than '%c'.", (intmax_t)ge, (intmax_t)le);
+}
+
+void assert_greater_equal_sch_failed(const signed char ge, const signed char le, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert greater or equal failed: '%c' is lesser than '%c'.", (intmax_t)ge, (intmax_t)le);
+}
+
+void assert_greater_equal_uch_failed(const unsigned char ge, const unsigned char le, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert greater or equal failed: '%c' is lesser than '%c'.", (intmax_t)ge, (intmax_t)le);
+}
+
+void assert_greater_equal_int_failed(const intmax_t ge, const intmax_t le, char *file, const int line)
+{
+    register_fail(file, line, operand_int, "Assert greater or equal failed: '%ld' is lesser than '%ld'.", ge, le);
+}
+
+void assert_greater_equal_uint_failed(const uintmax_t ge, const uintmax_t le, char *file, const int line)
+{
+    register_fail(file, line, operand_uint, "Assert greater or equal failed: '%ld' is lesser than '%ld'.", ge, le);
+}
+
+/**
+ * Tests whether the first long double is greater than, or at most LDBL_EPSILON apart from, the
+ * second. The tolerance is absolute, see assert_are_equal_ldbl(). An assert with a NaN operand
+ * passes.
+ *
+ * @param ge The value that is expected to be greater or equal to the second value.
+ * @param le The value that is expected to be less than or equal to the first value.
+ *
+ * @remarks Use assert_greater_equal_precision() to compare with an application specific tolerance.
+ */
+void assert_greater_equal_ldbl(const long double ge, const long double le, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(fabsl(ge - le) > LDBL_EPSILON && ge < le)
+    {
+        register_fail(file, line, operand_ldbl, "Assert greater or equal failed: '%0.8Lf' is lesser than '%0.8Lf'.", ge, le);
+    }
+}
+
+/** Tests whether the first float is greater than, or at most EZTEST_MAX_ULPS apart from, the second. */
+void assert_greater_equal_flt(const float ge, const float le, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(!(ge >= le) && !almost_equal_flt(ge, le))
+    {
+        register_fail(file, line, operand_dbl, "Assert greater or equal failed: '%.9g' (%a) is lesser than '%.9g' (%a).", (double)ge, (double)le);
+    }
+}
+
+/** Tests whether the first double is greater than, or at most EZTEST_MAX_ULPS apart from, the second. */
+void assert_greater_equal_dbl(const double ge, const double le, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(!(ge >= le) && !almost_equal_dbl(ge, le))
+    {
+        register_fail(file, line, operand_dbl, "Assert greater or equal failed: '%.17g' (%a) is lesser than '%.17g' (%a).", (double)ge, (double)le);
+    }
+}
+
+void assert_greater_equal_str(const char *ge, const char *le, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((ge == NULL && le != NULL) ||
+       (ge != NULL && le != NULL && strcmp(ge, le) < 0))
+    {
+        register_fail(file, line, operand_str, "Assert greater or equal failed: '%s' is lesser than '%s'.", ge, le);
+    }
+}
+
+void assert_greater_equal_wstr(const wchar_t *ge, const wchar_t *le, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((ge == NULL && le != NULL) ||
+       (ge != NULL && le != NULL && wcscmp(ge, le) < 0))
+    {
+        register_fail(file, line, operand_wstr, "Assert greater or equal failed: '%ls' is lesser than '%ls'.", ge, le);
+    }
+}
+void assert_greater_equal(const void *ge, const void *le, char *file, const int line)
+{
+    eztest_assert_count++;
+    register_fail(file, line, operand_none, "Assert greater or equal failed: unsupported data type.");
+}
+
+void assert_greater_equal_precision(long double  ge,
+                                     long double  le,
+                                     long double  epsilon,
+                                     char        *file,
+                                     int          line)
+{
+    eztest_assert_count++;
+    if(fabsl(ge - le) > epsilon && ge < le)
+    {
+        register_fail(file, line, operand_ldbl, "Assert greater or equal failed: '%0.8Lf' is lesser than '%0.8Lf'.", ge, le);
+    }
+}
+
+void assert_less_ch_failed(const char lesser, const char greater, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert less failed: '%c' is not lesser then '%c'.", (intmax_t)lesser, (intmax_t)greater);
+}
+
+void assert_less_sch_failed(const signed char lesser, const signed char greater, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert less failed: '%c' is not lesser then '%c'.", (intmax_t)lesser, (intmax_t)greater);
+}
+
+void assert_less_uch_failed(const unsigned char lesser, const unsigned char greater, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert less failed: '%c' is not lesser then '%c'.", (intmax_t)lesser, (intmax_t)greater);
+}
+
+void assert_less_int_failed(const intmax_t lesser, const intmax_t greater, char *file, const int line)
+{
+    register_fail(file, line, operand_int, "Assert less failed: '%ld' is not lesser then '%ld'.", lesser, greater);
+}
+
+void assert_less_uint_failed(const uintmax_t lesser, const uintmax_t greater, char *file, const int line)
+{
+    register_fail(file, line, operand_uint, "Assert less failed: '%ld' is not lesser then '%ld'.", lesser, greater);
+}
+
+/**
+ * Tests whether the first long double is lesser than, and more than LDBL_EPSILON apart from,
+ * the second. The tolerance is absolute, see assert_are_equal_ldbl(). An assert with a NaN
+ * operand passes.
+ *
+ * @param lesser  The value that is expected to be lesser.
+ * @param greater The value that is expected to be greater.
+ *
+ * @remarks Use assert_less_precision() to compare with an application specific tolerance.
+ */
+void assert_less_ldbl(const long double lesser, const long double greater, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(fabsl(greater - lesser) <= LDBL_EPSILON || lesser > greater)
+    {
+        register_fail(file, line, operand_ldbl, "Assert less failed: '%0.8Lf' is not lesser then '%0.8Lf'.", lesser, greater);
+    }
+}
+
+/** Tests whether the first float is lesser than, and more than EZTEST_MAX_ULPS apart from, the second. */
+void assert_less_flt(const float lesser, const float greater, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(!(lesser < greater) || almost_equal_flt(lesser, greater))
+    {
+        register_fail(file, line, operand_dbl, "Assert less failed: '%.9g' (%a) is not lesser than '%.9g' (%a).", (double)lesser, (double)greater);
+    }
+}
+
+/** Tests whether the first double is lesser than, and more than EZTEST_MAX_ULPS apart from, the second. */
+void assert_less_dbl(const double lesser, const double greater, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(!(lesser < greater) || almost_equal_dbl(lesser, greater))
+    {
+        register_fail(file, line, operand_dbl, "Assert less failed: '%.17g' (%a) is not lesser than '%.17g' (%a).", (double)lesser, (double)greater);
+    }
+}
+
+void assert_less_str(const char *lesser, const char *greater, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((greater == NULL && lesser != NULL) ||
+       (greater == NULL && lesser == NULL) ||
+       (greater != NULL && lesser != NULL && strcmp(lesser, greater) >= 0))
+    {
+        register_fail(file, line, operand_str, "Assert less failed: '%s' is not lesser then '%s'.", lesser, greater);
+    }
+}
+
+void assert_less_wstr(const wchar_t *lesser, const wchar_t *greater, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((greater == NULL && lesser != NULL) ||
+       (greater == NULL && lesser == NULL) ||
+       (greater != NULL && lesser != NULL && wcscmp(lesser, greater) >= 0))
+    {
+        register_fail(file, line, operand_wstr, "Assert less failed: '%ls' is not lesser then '%ls'.", lesser, greater);
+    }
+}
+
+/** Triggered when attempting to compare using an unsupported data type. */
+void assert_less(const void *lesser, const void *greater, char *file, const int line)
+{
+    eztest_assert_count++;
+    register_fail(file, line, operand_none, "Assert less failed: unsupported data type.");
+}
+
+void assert_less_precision(const long double  lesser,
+                            const long double  greater,
+                            const long double  epsilon,
+                            char              *file,
+                            const int          line)
+{
+    eztest_assert_count++;
+    if(fabsl(lesser - greater) <= epsilon || lesser > greater)
+    {
+        register_fail(file, line, operand_ldbl, "Assert less failed: '%0.8Lf' is not lesser then '%0.8Lf'.", lesser, greater);
+    }
+}
+
+void assert_less_equal_ch_failed(const char le, const char ge, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert less or equal failed: '%c' is greater then '%c'.", (intmax_t)le, (intmax_t)ge);
+}
+
+void assert_less_equal_sch_failed(const signed char le, const signed char ge, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert less or equal failed: '%c' is greater then '%c'.", (intmax_t)le, (intmax_t)ge);
+}
+
+void assert_less_equal_uch_failed(const unsigned char le, const unsigned char ge, char *file, const int line)
+{
+    register_fail(file, line, operand_char, "Assert less or equal failed: '%c' is greater then '%c'.", (intmax_t)le, (intmax_t)ge);
+}
+
+void assert_less_equal_int_failed(const intmax_t le, const intmax_t ge, char *file, const int line)
+{
+    register_fail(file, line, operand_int, "Assert less or equal failed: '%ld' is greater then '%ld'.", le, ge);
+}
+
+void assert_less_equal_uint_failed(const uintmax_t le, const uintmax_t ge, char *file, const int line)
+{
+    register_fail(file, line, operand_uint, "Assert less or equal failed: '%ld' is greater then '%ld'.", le, ge);
+}
+
+/**
+ * Tests whether the first long double is lesser than, or at most LDBL_EPSILON apart from, the
+ * second. The tolerance is absolute, see assert_are_equal_ldbl(). An assert with a NaN operand
+ * passes.
+ *
+ * @param le The value that is expected to be lesser or equal to the second value.
+ * @param ge The value that is expected to be greater than or equal to the first value.
+ *
+ * @remarks Use assert_less_equal_precision() to compare with an application specific tolerance.
+ */
+void assert_less_equal_ldbl(const long double le, const long double ge, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(fabsl(ge - le) > LDBL_EPSILON && le > ge)
+    {
+        register_fail(file, line, operand_ldbl, "Assert less or equal failed: '%0.8Lf' is greater then '%0.8Lf'.", le, ge);
+    }
+}
+
+/** Tests whether the first float is lesser than, or at most EZTEST_MAX_ULPS apart from, the second. */
+void assert_less_equal_flt(const float le, const float ge, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(!(le <= ge) && !almost_equal_flt(le, ge))
+    {
+        register_fail(file, line, operand_dbl, "Assert less or equal failed: '%.9g' (%a) is greater than '%.9g' (%a).", (double)le, (double)ge);
+    }
+}
+
+/** Tests whether the first double is lesser than, or at most EZTEST_MAX_ULPS apart from, the second. */
+void assert_less_equal_dbl(const double le, const double ge, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(!(le <= ge) && !almost_equal_dbl(le, ge))
+    {
+        register_fail(file, line, operand_dbl, "Assert less or equal failed: '%.17g' (%a) is greater than '%.17g' (%a).", (double)le, (double)ge);
+    }
+}
+
+void assert_less_equal_str(const char *le, const char *ge, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((ge == NULL && le != NULL) ||
+       (ge != NULL && le != NULL && strcmp(le, ge) > 0))
+    {
+        register_fail(file, line, operand_str, "Assert less or equal failed: '%s' is greater then '%s'.", le, ge);
+    }
+}
+
+void assert_less_equal_wstr(const wchar_t *le, const wchar_t *ge, char *file, const int line)
+{
+    eztest_assert_count++;
+    if((ge == NULL && le != NULL) ||
+       (ge != NULL && le != NULL && wcscmp(le, ge) > 0))
+    {
+        register_fail(file, line, operand_wstr, "Assert less or equal failed: '%ls' is greater then '%ls'.", le, ge);
+    }
+}
+void assert_less_equal(const void *le, const void *ge, char *file, const int line)
+{
+    eztest_assert_count++;
+    register_fail(file, line, operand_none, "Assert less or equal failed: unsupported data type.");
+}
+
+void assert_less_equal_precision(const long double  le,
+                                  const long double  ge,
+                                  const long double  epsilon,
+                                  char              *file,
+                                  const int          line)
+{
+    eztest_assert_count++;
+    if(fabsl(le - ge) > epsilon && le > ge)
+    {
+        register_fail(file, line, operand_ldbl, "Assert less or equal failed: '%0.8Lf' is greater then '%0.8Lf'.", le, ge);
+    }
+}
+
+
+//endregion asserts
+
+//region snapshots
+
+/** A recorded snapshot hash. */
+struct snapshot
+{
+    /** The next snapshot in the order of the snapshot file. */
+    struct snapshot *next;
+    /** The next snapshot in the same bucket. */
+    struct snapshot *chain;
+    /** The test and the ordinal of the snapshot assert within the test, separated by a tab. */
+    const char *key;
+    /** The amount of hashed bytes. */
+    uint64_t size;
+    /** The hash of the bytes. */
+    uint64_t hash;
+    /** The hash of each block of bytes, @code NULL @endcode if the blocks were not recorded. */
+    uint64_t *blocks;
+    /** Whether a snapshot assert of this run reached the snapshot. */
+    bool visited;
+    /** Whether the snapshot is left out of the snapshot file, as its test no longer reaches it. */
+    bool dropped;
+};
+
+/** The amount of buckets of the snapshot table. */
+#define EZTEST_SNAPSHOT_BUCKETS 1024
+
+/** The snapshots of the snapshot file, loaded by the first snapshot assert. */
+static struct
+{
+    struct arena arena;
+    struct snapshot *buckets[EZTEST_SNAPSHOT_BUCKETS];
+    struct snapshot *head;
+    struct snapshot **tail;
+    /** The amount of snapshot asserts of the current test so far. */
+    unsigned int ordinal;
+    bool loaded;
+    bool changed;
+} snapshots = { { NULL, NULL }, { NULL }, NULL, &snapshots.head, 0, false, false };
+
+/** @return The amount of blocks of EZTEST_SNAPSHOT_BLOCK_SIZE bytes needed for the given size. */
+static inline size_t snapshot_block_count(const uint64_t size)
+{
+    return (size_t)((size + EZTEST_SNAPSHOT_BLOCK_SIZE - 1) / EZTEST_SNAPSHOT_BLOCK_SIZE);
+}
+
+/**
+ * Finds the snapshot with the given key, optionally adding it if it does not exist.
+ *
+ * @param key    The test and the ordinal of the snapshot assert, separated by a tab.
+ * @param create When set to @code true @endcode a missing snapshot is added.
+ * @return The snapshot, or @code NULL @endcode if it does not exist and was not added.
+ */
+static struct snapshot *snapshot_find(const char *key, const bool create)
+{
+    const size_t len = strlen(key);
+    struct snapshot **slot = &snapshots.buckets[xxh64(key, len, 0) % EZTEST_SNAPSHOT_BUCKETS];
+    for(; *slot != NULL; slot = &(*slot)->chain)
+    {
+        if(strcmp((*slot)->key, key) == 0)
+        {
+            return *slot;
+        }
+    }
+    if(!create)
+    {
+        return NULL;
+    }
+
+    struct snapshot *snapshot = arena_alloc(&snapshots.arena, sizeof(struct snapshot) + len + 1);
+    if(snapshot == NULL)
+    {
+        return NULL;
+    }
+    memcpy(snapshot + 1, key, len + 1);
+    snapshot->key    = (const char *)(snapshot + 1);
+    snapshot->next   = NULL;
+    snapshot->chain  = NULL;
+    snapshot->size   = 0;
+    snapshot->hash   = 0;
+    snapshot->blocks = NULL;
+    snapshot->visited = false;
+    snapshot->dropped = false;
+    *slot = snapshot;
+    *snapshots.tail = snapshot;
+    snapshots.tail = &snapshot->next;
+    return snapshot;
+}
+
+/**
+ * Parses a line of the snapshot file: the test, the ordinal, the size, the hash and optionally
+ * the block hashes, separated by tabs. The block hashes are separated by spaces. Malformed
+ * lines are ignored.
+ *
+ * @param line The line, without the line break. Its tabs are replaced while parsing.
+ */
+static void snapshot_parse(char *line)
+{
+    char *site = strchr(line, '\t');
+    char *fields = site == NULL ? NULL : strchr(site + 1, '\t');
+    if(fields == NULL)
+    {
+        return;
+    }
+    *fields++ = '\0';
+
+    char *end;
+    const uint64_t size = strtoull(fields, &end, 10);
+    if(end == fields || *end != '\t')
+    {
+        return;
+    }
+    fields = end + 1;
+    const uint64_t hash = strtoull(fields, &end, 16);
+    if(end == fields || (*end != '\t' && *end != '\0'))
+    {
+        return;
+    }
+
+    uint64_t *blocks = NULL;
+    if(*end == '\t')
+    {
+        const size_t count = snapshot_block_count(size);
+        blocks = arena_alloc(&snapshots.arena, count * sizeof(uint64_t) + 1);
+        if(blocks == NULL)
+        {
+            return;
+        }
+        for(size_t i = 0; i < count; i++)
+        {
+            fields = end + 1;
+            blocks[i] = strtoull(fields, &end, 16);
+            if(end == fields || *end != (i + 1 < count ? ' ' : '\0'))
+            {
+                return;
+            }
+        }
+    }
+
+    struct snapshot *snapshot = snapshot_find(line, true);
+    if(snapshot != NULL)
+    {
+        snapshot->size   = size;
+        snapshot->hash   = hash;
+        snapshot->blocks = blocks;
+    }
+}
+
+/** Loads the snapshot file, once. A missing snapshot file has no snapshots. */
+static void snapshot_load(void)
+{
+    if(snapshots.loaded)
+    {
+        return;
+    }
+    snapshots.loaded = true;
+
+    FILE *file = fopen(EZTEST_SNAPSHOT_FILE, "r");
+    if(file == NULL)
+    {
+        return;
+    }
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t len;
+    while((len = getline(&line, &cap, file)) != -1)
+    {
+        if(len > 0 && line[len - 1] == '\n')
+        {
+            line[len - 1] = '\0';
+        }
+        snapshot_parse(line);
+    }
+    free(line);
+    fclose(file);
+}
+
+/**
+ * Writes the snapshots to the snapshot file if any snapshot was recorded, and frees them.
+ *
+ * @return @code EZTEST_RESULT_OK @endcode on success; otherwise @code EZTEST_RESULT_ERR @endcode.
+ */
+static int snapshot_save(void)
+{
+    int result = EZTEST_RESULT_OK;
+    if(snapshots.changed)
+    {
+        char *data = NULL;
+        size_t size = 0;
+        FILE *stream = open_memstream(&data, &size);
+        if(stream == NULL)
+        {
+            result = EZTEST_RESULT_ERR;
+        }
+        else
+        {
+            for(const struct snapshot *snapshot = snapshots.head; snapshot != NULL; snapshot = snapshot->next)
+            {
+                if(snapshot->dropped)
+                {
+                    continue;
+                }
+                fprintf(stream, "%s\t%" PRIu64 "\t%016" PRIx64, snapshot->key, snapshot->size, snapshot->hash);
+                const size_t count = snapshot->blocks == NULL ? 0 : snapshot_block_count(snapshot->size);
+                for(size_t i = 0; i < count; i++)
+                {
+                    fprintf(stream, "%c%016" PRIx64, i == 0 ? '\t' : ' ', snapshot->blocks[i]);
+                }
+                if(snapshot->blocks != NULL && count == 0)
+                {
+                    fputc('\t', stream);
+                }
+                fputc('\n', stream);
+            }
+            struct stat st;
+            const mode_t mode = stat(EZTEST_SNAPSHOT_FILE, &st) == 0 ? st.st_mode & 07777 : 0644;
+            if(fclose(stream) != 0 || replace_file(EZTEST_SNAPSHOT_FILE, data, size, mode) != EZTEST_RESULT_OK)
+            {
+                result = EZTEST_RESULT_ERR;
+            }
+            free(data);
+        }
+        if(result != EZTEST_RESULT_OK)
+        {
+            fprintf(stderr, "Failed to write the snapshot file '%s'.\n", EZTEST_SNAPSHOT_FILE);
+        }
+    }
+    arena_free(&snapshots.arena);
+    return result;
+}
+
+/**
+ * Hashes each block of the given bytes.
+ *
+ * @return The block hashes allocated from the snapshot arena, or @code NULL @endcode if out of memory.
+ */
+static uint64_t *snapshot_blocks(const unsigned char *bytes, const size_t size)
+{
+    const size_t count = snapshot_block_count(size);
+    uint64_t *blocks = arena_alloc(&snapshots.arena, count * sizeof(uint64_t) + 1);
+    for(size_t i = 0; blocks != NULL && i < count; i++)
+    {
+        const size_t offset = i * EZTEST_SNAPSHOT_BLOCK_SIZE;
+        const size_t n = size - offset < EZTEST_SNAPSHOT_BLOCK_SIZE ? size - offset : EZTEST_SNAPSHOT_BLOCK_SIZE;
+        blocks[i] = xxh64(bytes + offset, n, 0);
+    }
+    return blocks;
+}
+
+/**
+ * Lists the blocks of the given bytes that differ from the recorded blocks, as ranges of block
+ * indexes. Blocks that exist in only one of them count as changed.
+ *
+ * @param report Where to write the list, starting with a line break.
+ */
+static void snapshot_report(const struct snapshot *snapshot, const unsigned char *bytes, const size_t size,
+                            char *report, const size_t report_size)
+{
+    const size_t recorded = snapshot_block_count(snapshot->size);
+    const size_t count = snapshot_block_count(size);
+    const size_t total = recorded > count ? recorded : count;
+
+    size_t changed = 0, ranges = 0, len = 0, first = 0;
+    bool in_range = false;
+    char list[EZTEST_SNAPSHOT_MAX_RANGES * 48] = "";
+    for(size_t i = 0; i <= total; i++)
+    {
+        bool differs = false;
+        if(i < total)
+        {
+            differs = i >= recorded || i >= count;
+            if(!differs)
+            {
+                const size_t offset = i * EZTEST_SNAPSHOT_BLOCK_SIZE;
+                const size_t n = size - offset < EZTEST_SNAPSHOT_BLOCK_SIZE ? size - offset : EZTEST_SNAPSHOT_BLOCK_SIZE;
+                differs = xxh64(bytes + offset, n, 0) != snapshot->blocks[i];
+            }
+        }
+        if(differs)
+        {
+            changed++;
+            if(!in_range)
+            {
+                first = i;
+                in_range = true;
+            }
+        }
+        else if(in_range)
+        {
+            in_range = false;
+            if(ranges++ < EZTEST_SNAPSHOT_MAX_RANGES)
+            {
+                len = format_append(list, sizeof(list), len, first + 1 == i ? "%s%zu" : "%s%zu-%zu",
+                                    ranges > 1 ? ", " : "", first, i - 1);
+            }
+        }
+    }
+    snprintf(report, report_size, "\n    %zu of %zu blocks of %zu bytes changed: %s%s", changed, total,
+             (size_t)EZTEST_SNAPSHOT_BLOCK_SIZE, list, ranges > EZTEST_SNAPSHOT_MAX_RANGES ? ", ..." : "");
+}
+
+/**
+ * Ends the snapshot asserts of the current test. When recording, the snapshots of a passed test
+ * after the last one it reached are dropped from the snapshot file, as the test no longer has
+ * those asserts. The snapshots of a failed test are kept, it may have ended before reaching them.
+ *
+ * @param passed Whether the test passed.
+ */
+static void snapshot_test_end(const bool passed)
+{
+    snapshots.ordinal = 0;
+    if(!options->update_snapshots || !snapshots.loaded || !passed)
+    {
+        return;
+    }
+    const size_t key_size = strlen(current->test_suite) + strlen(current->test_name) + 16;
+    char *key = malloc(key_size);
+    for(unsigned int ordinal = 1; key != NULL; ordinal++)
+    {
+        snprintf(key, key_size, "%s.%s\t%u", current->test_suite, current->test_name, ordinal);
+        struct snapshot *snapshot = snapshot_find(key, false);
+        if(snapshot == NULL)
+        {
+            break;
+        }
+        if(!snapshot->visited && !snapshot->dropped)
+        {
+            snapshot->dropped = true;
+            snapshots.changed = true;
+        }
+    }
+    free(key);
+}
+
+void assert_snapshot_hash(const void *actual, const size_t size, const bool blocks, char *file, const int line)
+{
+    eztest_assert_count++;
+    if(actual == NULL && size > 0)
+    {
+        register_fail(file, line, operand_none, "Assert snapshot hash failed: value is NULL.");
+        return;
+    }
+    snapshot_load();
+
+    const uint64_t hash = xxh64(actual, size, 0);
+    // Keyed by the ordinal instead of the line, so that moving an assert keeps its snapshot.
+    const size_t key_size = strlen(current->test_suite) + strlen(current->test_name) + 16;
+    char *key = malloc(key_size);
+    if(key == NULL)
+    {
+        register_fail(file, line, operand_none, "Assert snapshot hash failed: out of memory.");
+        return;
+    }
+    snprintf(key, key_size, "%s.%s\t%u", current->test_suite, current->test_name, ++snapshots.ordinal);
+    struct snapshot *snapshot = snapshot_find(key, options->update_snapshots);
+
+    if(options->update_snapshots)
+    {
+        if(snapshot == NULL)
+        {
+            register_fail(file, line, operand_none, "Assert snapshot hash failed: out of memory.");
+        }
+        else
+        {
+            if(snapshot->hash != hash || snapshot->size != size || (snapshot->blocks != NULL) != blocks)
+            {
+                snapshot->size   = size;
+                snapshot->hash   = hash;
+                snapshot->blocks = blocks ? snapshot_blocks(actual, size) : NULL;
+                snapshots.changed = true;
+            }
+            snapshot->visited = true;
+            snapshot->dropped = false;
+            // A forked test process ends without saving, the runner process records the snapshot instead.
+            // Unchanged snapshots are sent as well, so that the runner process knows they were reached.
+            if(result_pipe >= 0)
+            {
+                send_snapshot(key, size, hash, snapshot->blocks, snapshot_block_count(size));
+            }
+        }
+        free(key);
+        return;
+    }
+    free(key);
+    if(snapshot == NULL)
+    {
+        register_fail(file, line, operand_none,
+                      "Assert snapshot hash failed: no snapshot is recorded, run with --update-snapshots to record it.");
+        return;
+    }
+    if(snapshot->hash == hash && snapshot->size == size)
+    {
+        return;
+    }
+
+    char summary[128];
+    char report[EZTEST_SNAPSHOT_MAX_RANGES * 48 + 96] = "";
+    snprintf(summary, sizeof(summary), "expected %016" PRIx64 " (%" PRIu64 " bytes), but got %016" PRIx64 " (%zu bytes).",
+             snapshot->hash, snapshot->size, hash, size);
+    if(snapshot->blocks != NULL && !options->quiet)
+    {
+        snapshot_report(snapshot, actual, size, report, sizeof(report));
+    }
+    register_fail(file, line, operand_str, "Assert snapshot hash failed: %s%s", summary, report);
+}
+
+//endregion snapshots
+
+//region properties
+
+/** @return The next random number of the given splitmix64 state. */
+static uint64_t property_random(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/** @return The value closest to 0 (zero) within the range of the generator, which arguments are shrunk toward. */
+static int64_t property_int_target(const struct eztest_gen *gen)
+{
+    return gen->min > 0 ? gen->min : gen->max < 0 ? gen->max : 0;
+}
+
+/** @see property_int_target(gen); */
+static double property_float_target(const struct eztest_gen *gen)
+{
+    return gen->fmin > 0 ? gen->fmin : gen->fmax < 0 ? gen->fmax : 0;
+}
+
+/** @return The smallest byte of the given kind of buffer, which its bytes are shrunk toward. */
+static unsigned char property_smallest(const struct eztest_gen *gen)
+{
+    return gen->kind == EZTEST_GEN_STRING ? 'a' : 0;
+}
+
+/**
+ * Generates an argument. One in eight arguments is an edge case: a bound of the range, the
+ * target of the range or an empty or full buffer.
+ *
+ * @param gen   The generator of the argument.
+ * @param arg   Set to the generated argument.
+ * @param rng   The state of the random numbers.
+ * @param arena The arena to allocate buffers from.
+ * @return On success @code EZTEST_RESULT_OK @endcode; otherwise @code EZTEST_RESULT_ERR @endcode if out of memory.
+ */
+static int property_generate(const struct eztest_gen *gen, struct eztest_arg *arg, uint64_t *rng, struct arena *arena)
+{
+    const uint64_t r = property_random(rng);
+    const bool edge = (r & 7) == 0;
+    *arg = (struct eztest_arg){ 0 };
+    switch(gen->kind)
+    {
+        case EZTEST_GEN_INT:
+        {
+            const int64_t edges[3] = { gen->min, gen->max, property_int_target(gen) };
+            const uint64_t span = (uint64_t)gen->max - (uint64_t)gen->min;
+            const uint64_t value = property_random(rng);
+            arg->i = edge ? edges[(r >> 3) % 3]
+                   : (int64_t)((uint64_t)gen->min + (span == UINT64_MAX ? value : value % (span + 1)));
+            return EZTEST_RESULT_OK;
+        }
+
+        case EZTEST_GEN_FLOAT:
+        {
+            const double edges[3] = { gen->fmin, gen->fmax, property_float_target(gen) };
+            const double u = (double)(property_random(rng) >> 11) * 0x1p-53;
+            // Interpolated this way, the full range of double does not overflow.
+            const double value = gen->fmin * (1 - u) + gen->fmax * u;
+            arg->f = edge ? edges[(r >> 3) % 3] : value < gen->fmin ? gen->fmin : value > gen->fmax ? gen->fmax : value;
+            return EZTEST_RESULT_OK;
+        }
+
+        case EZTEST_GEN_BYTES:
+        case EZTEST_GEN_STRING:
+        {
+            arg->size = edge ? ((r >> 3) & 1) * gen->max_size : property_random(rng) % (gen->max_size + 1);
+            unsigned char *bytes = arena_alloc(arena, arg->size + 1);
+            if(bytes == NULL)
+            {
+                return EZTEST_RESULT_ERR;
+            }
+            for(size_t i = 0; i < arg->size; i += sizeof(uint64_t))
+            {
+                const uint64_t word = property_random(rng);
+                memcpy(bytes + i, &word, arg->size - i < sizeof(word) ? arg->size - i : sizeof(word));
+            }
+            if(gen->kind == EZTEST_GEN_STRING)
+            {
+                for(size_t i = 0; i < arg->size; i++)
+                {
+                    bytes[i] = (unsigned char)(' ' + bytes[i] % 95);
+                }
+            }
+            bytes[arg->size] = '\0';
+            arg->bytes = gen->kind == EZTEST_GEN_BYTES ? bytes : NULL;
+            arg->str   = gen->kind == EZTEST_GEN_STRING ? (const char *)bytes : NULL;
+            return EZTEST_RESULT_OK;
+        }
+    }
+    return EZTEST_RESULT_ERR;
+}
+
+/**
+ * Runs the property with the given arguments, without reporting failing asserts.
+ *
+ * @return True if an assert failed; otherwise false.
+ */
+static bool property_fails(void (*property)(const struct eztest_arg *args), const struct eztest_arg *args)
+{
+    property_failed = false;
+    property_probe = true;
+    property(args);
+    property_probe = false;
+    arena_reset(&test_arena);
+    return property_failed;
+}
+
+/** @return A pointer to the bytes of the given buffer argument. */
+static const unsigned char *property_buffer(const struct eztest_arg *arg)
+{
+    return arg->bytes != NULL ? arg->bytes : (const unsigned char *)arg->str;
+}
+
+/**
+ * Makes the given candidate of shrinking an argument. The candidates are tried in order from the
+ * one shrinking the most: an integer or float moves to its target and then half way toward it,
+ * a buffer drops chunks of halving size and then moves each byte to the smallest byte.
+ *
+ * @param gen       The generator of the argument.
+ * @param arg       The argument to shrink.
+ * @param candidate The index of the candidate.
+ * @param shrunk    Set to the candidate, a buffer is allocated from the arena.
+ * @return True if the candidate exists; otherwise false.
+ */
+static bool property_shrink(const struct eztest_gen *gen, const struct eztest_arg *arg, size_t candidate,
+                            struct eztest_arg *shrunk, struct arena *arena)
+{
+    *shrunk = *arg;
+    switch(gen->kind)
+    {
+        case EZTEST_GEN_INT:
+        {
+            // The distance to the target fits, as the target is 0 (zero) or the bound nearest to it.
+            const int64_t distance = arg->i - property_int_target(gen);
+            if(candidate > 62 || distance / ((int64_t)1 << candidate) == 0)
+            {
+                return false;
+            }
+            shrunk->i = arg->i - distance / ((int64_t)1 << candidate);
+            return true;
+        }
+
+        case EZTEST_GEN_FLOAT:
+        {
+            // The candidates are the target, the value without its fraction and then moves toward the target.
+            const double target = property_float_target(gen);
+            for(; candidate < 64; candidate++)
+            {
+                const double f = candidate == 0 ? target
+                               : candidate == 1 ? (fabs(arg->f) < 0x1p62 ? (double)(int64_t)arg->f : arg->f)
+                               : arg->f - (arg->f - target) / (double)((uint64_t)1 << (candidate - 1));
+                if(f != arg->f && f >= gen->fmin && f <= gen->fmax && fabs(f - target) < fabs(arg->f - target))
+                {
+                    shrunk->f = f;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        case EZTEST_GEN_BYTES:
+        case EZTEST_GEN_STRING:
+        {
+            const unsigned char *bytes = property_buffer(arg);
+            size_t drop_at = 0, drop = 0, set_at = SIZE_MAX;
+            for(size_t chunk = arg->size; chunk > 0 && drop == 0; chunk /= 2)
+            {
+                const size_t chunks = (arg->size + chunk - 1) / chunk;
+                if(candidate < chunks)
+                {
+                    drop_at = candidate * chunk;
+                    drop = arg->size - drop_at < chunk ? arg->size - drop_at : chunk;
+                }
+                candidate -= chunks;
+            }
+            for(size_t i = 0; i < arg->size && drop == 0 && set_at == SIZE_MAX; i++)
+            {
+                if(bytes[i] != property_smallest(gen) && candidate-- == 0)
+                {
+                    set_at = i;
+                }
+            }
+            if(drop == 0 && set_at == SIZE_MAX)
+            {
+                return false;
+            }
+
+            unsigned char *copy = arena_alloc(arena, arg->size - drop + 1);
+            if(copy == NULL)
+            {
+                return false;
+            }
+            memcpy(copy, bytes, drop_at);
+            memcpy(copy + drop_at, bytes + drop_at + drop, arg->size - drop_at - drop);
+            shrunk->size = arg->size - drop;
+            copy[shrunk->size] = '\0';
+            if(set_at != SIZE_MAX)
+            {
+                copy[set_at] = property_smallest(gen);
+            }
+            shrunk->bytes = arg->bytes != NULL ? copy : NULL;
+            shrunk->str   = arg->str != NULL ? (const char *)copy : NULL;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Appends the given argument to the report of a failed property test.
+ *
+ * @return The new length of the report, as @see format_append.
+ */
+static size_t property_append(char *report, const size_t size, size_t len, const size_t index,
+                              const struct eztest_gen *gen, const struct eztest_arg *arg)
+{
+    len = format_append(report, size, len, "\n    args[%zu] = ", index);
+    switch(gen->kind)
+    {
+        case EZTEST_GEN_INT:
+            return format_append(report, size, len, "%" PRId64, arg->i);
+
+        case EZTEST_GEN_FLOAT:
+            return format_append(report, size, len, "%.17g", arg->f);
+
+        case EZTEST_GEN_BYTES:
+            len = format_append(report, size, len, "{");
+            for(size_t i = 0; i < arg->size && i < EZTEST_MAX_PRINTABLE_LEN; i++)
+            {
+                len = format_append(report, size, len, "%s0x%02x", i > 0 ? ", " : "", arg->bytes[i]);
+            }
+            return format_append(report, size, len, "%s} (%zu bytes)",
+                                 arg->size > EZTEST_MAX_PRINTABLE_LEN ? ", .." : "", arg->size);
+
+        case EZTEST_GEN_STRING:
+            len = format_append(report, size, len, "\"");
+            for(size_t i = 0; i < arg->size && i < 4 * EZTEST_MAX_PRINTABLE_LEN; i++)
+            {
+                const char c = arg->str[i];
+                len = format_append(report, size, len, c == '"' || c == '\\' ? "\\%c" : "%c", c);
+            }
+            return format_append(report, size, len, "\"%s (%zu characters)",
+                                 arg->size > 4 * EZTEST_MAX_PRINTABLE_LEN ? ".." : "", arg->size);
+    }
+    return len;
+}
+
+/**
+ * Shrinks the failing arguments of a property test to a minimal counterexample. Each argument
+ * is replaced by its first candidate for which the property still fails, until no candidate
+ * of any argument fails or @see EZTEST_PROPERTY_SHRINKS runs have been made.
+ *
+ * @param args  The failing arguments, replaced by the counterexample. Buffers are allocated from the arena.
+ * @return The amount of times the arguments were shrunk.
+ */
+static size_t property_minimize(const struct eztest_gen *gens, const size_t count,
+                                void (*property)(const struct eztest_arg *args), struct eztest_arg *args,
+                                struct arena *arena)
+{
+    size_t shrinks = 0, runs = 0;
+    bool progress = true;
+    while(progress && runs < EZTEST_PROPERTY_SHRINKS)
+    {
+        progress = false;
+        for(size_t i = 0; i < count; i++)
+        {
+            const struct eztest_arg kept = args[i];
+            for(size_t candidate = 0; runs < EZTEST_PROPERTY_SHRINKS; candidate++)
+            {
+                if(!property_shrink(&gens[i], &kept, candidate, &args[i], arena))
+                {
+                    args[i] = kept;
+                    break;
+                }
+                runs++;
+                if(property_fails(property, args))
+                {
+                    shrinks++;
+                    progress = true;
+                    break;
+                }
+                args[i] = kept;
+            }
+        }
+    }
+    return shrinks;
+}
+
+void eztest_property(const struct eztest_gen *gens, const size_t count, void (*property)(const struct eztest_arg *args),
+                     char *file, const int line)
+{
+    const size_t cases = options->property_cases > 0 ? options->property_cases : EZTEST_PROPERTY_CASES;
+
+    // Each property gets its own sequence, so that it replays the same however the tests are selected.
+    uint64_t rng = xxh64(current->test_name, strlen(current->test_name),
+                         xxh64(current->test_suite, strlen(current->test_suite), property_seed));
+
+    struct arena batch_arena = { NULL, NULL };
+    struct arena shrink_arena = { NULL, NULL };
+    for(size_t done = 0; done < cases; done += EZTEST_PROPERTY_BATCH)
+    {
+        const size_t n = cases - done < EZTEST_PROPERTY_BATCH ? cases - done : EZTEST_PROPERTY_BATCH;
+        arena_reset(&batch_arena);
+        struct eztest_arg *batch = arena_alloc(&batch_arena, n * count * sizeof(struct eztest_arg));
+        for(size_t i = 0; batch != NULL && i < n * count; i++)
+        {
+            if(property_generate(&gens[i % count], &batch[i], &rng, &batch_arena) != EZTEST_RESULT_OK)
+            {
+                batch = NULL;
+            }
+        }
+        if(batch == NULL)
+        {
+            register_fail(file, line, operand_str, "Property failed: %s%s", "out of memory generating the arguments.", "");
+            break;
+        }
+
+        for(size_t i = 0; i < n; i++)
+        {
+            struct eztest_arg *args = &batch[i * count];
+            if(!property_fails(property, args))
+            {
+                continue;
+            }
+
+            const size_t shrinks = property_minimize(gens, count, property, args, &shrink_arena);
+            property(args); // Reports the failing asserts of the counterexample.
+            arena_reset(&test_arena);
+
+            char summary[192], report[2048];
+            snprintf(summary, sizeof(summary),
+                     "falsified after %zu of %zu cases with seed %" PRIu64 ", replay with --seed=%" PRIu64 ". "
+                     "Shrunk %zu times to:", done + i + 1, cases, property_seed, property_seed, shrinks);
+            size_t len = 0;
+            report[0] = '\0';
+            for(size_t j = 0; j < count; j++)
+            {
+                len = property_append(report, sizeof(report), len, j, &gens[j], &args[j]);
+            }
+            register_fail(file, line, operand_str, "Property failed: %s%s", summary, report);
+            arena_free(&batch_arena);
+            arena_free(&shrink_arena);
+            return;
+        }
+    }
+    arena_free(&batch_arena);
+    arena_free(&shrink_arena);
+}
+
+//endregion properties
+
+//region fuzzing
+
+/** The coverage counters, incremented by the instrumented code and cleared after each run. */
+static uint8_t fuzz_counters[EZTEST_FUZZ_MAP_SIZE];
+
+/** The counters hit since they were last cleared, in the order they were first hit. */
+static uint32_t fuzz_touched[EZTEST_FUZZ_MAP_SIZE];
+
+/** The amount of touched counters, @see EZTEST_FUZZ_MAP_SIZE when too many were hit to list them. */
+static size_t fuzz_touched_count = 0;
+
+/** The amount of trace-pc-guard guards given a counter. */
+static size_t fuzz_guards = 0;
+
+/** An input of a fuzz test. */
+struct fuzz_input
+{
+    /** The file the input was read from or written to. */
+    const char *path;
+    unsigned char *data;
+    size_t size;
+};
+
+/** The inputs of a fuzz test, their paths and bytes are allocated from the arena. */
+struct fuzz_corpus
+{
+    struct fuzz_input *inputs;
+    size_t count;
+    size_t capacity;
+    struct arena arena;
+};
+
+/** The state of the fuzzed test shared with the signal handlers. */
+static struct
+{
+    /** The input being run, @code NULL @endcode while the fuzz target is not running. */
+    const unsigned char *volatile data;
+    size_t size;
+    /** The path of the crash directory, followed by room for the name of a crashing input. */
+    char crash_path[1024];
+    size_t crash_dir_len;
+    /** Set by SIGINT and SIGTERM to stop fuzzing. */
+    volatile sig_atomic_t stop;
+} fuzzing;
+
+/** The signals of a crashing fuzz target, the crashing input is saved before they are handled as before. */
+static const int fuzz_crash_signals[] = { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT };
+
+/** Keeps the coverage hooks from being instrumented themselves, which would recurse without end. */
+#if defined(__has_attribute) && __has_attribute(no_sanitize_coverage)
+#define EZTEST_NO_COVERAGE __attribute__((no_sanitize_coverage))
+#elif defined(__clang__)
+#define EZTEST_NO_COVERAGE __attribute__((no_sanitize("coverage")))
+#else
+#define EZTEST_NO_COVERAGE
+#endif
+
+/**
+ * Marks a coverage hook. The hooks are weak, so that a runtime defining its own, like libFuzzer,
+ * takes precedence instead of conflicting with the runner. Fuzz tests then find no new coverage.
+ */
+#define EZTEST_COVERAGE_HOOK EZTEST_NO_COVERAGE __attribute__((weak))
+
+/** Set when an AddressSanitizer runtime is linked, called before it reports an error and exits. */
+extern void __sanitizer_set_death_callback(void (*callback)(void)) __attribute__((weak));
+
+/**
+ * Called once for each instrumented module when compiled with -fsanitize-coverage=trace-pc-guard.
+ * Gives each guard its own counter, sharing counters once the map is full.
+ */
+EZTEST_COVERAGE_HOOK void __sanitizer_cov_trace_pc_guard_init(uint32_t *start, uint32_t *stop)
+{
+    if(start == stop || *start != 0)
+    {
+        return;
+    }
+    for(uint32_t *guard = start; guard < stop; guard++)
     {
-        mem_test_failed(greater, lesser, size, file, line, "Assert greater failed:", "is lesser than or equal to");
+        *guard = (uint32_t)(fuzz_guards++ % (EZTEST_FUZZ_MAP_SIZE - 1)) + 1;
     }
 }
 
-void assert_greater_equal_mem(const void *ge, const void *le, const size_t size, char *file, const int line)
+/** Increases the given counter, listing it as touched on its first hit. */
+EZTEST_NO_COVERAGE static inline void fuzz_hit(const size_t index)
 {
-    if((ge == NULL && le != NULL) ||
-       (ge != NULL && le != NULL && memcmp(ge, le, size) < 0))
+    if(fuzz_counters[index]++ == 0 && fuzz_touched_count < EZTEST_FUZZ_MAP_SIZE)
     {
-        mem_test_failed(ge, le, size, file, line, "Assert greater equal failed:", "is lesser than");
+        fuzz_touched[fuzz_touched_count++] = (uint32_t)index;
     }
 }
 
-void assert_less_mem(const void *lesser, const void *greater, const size_t size, char *file, const int line)
+/** Called on each edge of the code compiled with -fsanitize-coverage=trace-pc-guard. */
+EZTEST_COVERAGE_HOOK void __sanitizer_cov_trace_pc_guard(uint32_t *guard)
 {
-    if((lesser != NULL && greater == NULL) ||
-       (lesser == NULL && greater == NULL) ||
-       (lesser != NULL && greater != NULL && memcmp(lesser, greater, size) >= 0))
-    {
-        mem_test_failed(lesser, greater, size, file, line, "Assert lesser failed:", "is greater than or equal to");
-    }
+    fuzz_hit(*guard);
 }
 
-void assert_less_equal_mem(const void *le, const void *ge, const size_t size, char *file, const int line)
+/** Called on each basic block of the code compiled with -fsanitize-coverage=trace-pc, as GCC does. */
+EZTEST_COVERAGE_HOOK void __sanitizer_cov_trace_pc(void)
 {
-    if((le != NULL && ge == NULL) ||
-       (le != NULL && ge != NULL && memcmp(le, ge, size) > 0))
-    {
-        mem_test_failed(le, ge, size, file, line, "Assert less or equal failed:", "is greater than");
-    }
+    const uintptr_t pc = (uintptr_t)__builtin_return_address(0);
+    fuzz_hit((pc ^ (pc >> 16)) & (EZTEST_FUZZ_MAP_SIZE - 1));
 }
 
-void assert_are_equal_cmp(const void *expected, 
-                           const void *actual, 
-                           int(*cmp_fn)(const void *ptr1, const void *ptr2),
-                           char *file,
-                           const int line)
+/**
+ * Writes the given value as 16 hexadecimal digits followed by a null terminator.
+ *
+ * @remarks Safe to call from a signal handler.
+ */
+static void fuzz_hex(char *out, const uint64_t value)
 {
-    if(cmp_fn(expected, actual) != 0)
+    static const char digits[] = "0123456789abcdef";
+    for(int i = 0; i < 16; i++)
     {
-        register_fail(file, line, "Assert are equal failed.");
+        out[i] = digits[(value >> (60 - 4 * i)) & 0xf];
     }
+    out[16] = '\0';
 }
 
-void assert_are_not_equal_cmp(const void *unexpected, 
-                               const void *actual, 
-                               int(*cmp_fn)(const void *ptr1, const void *ptr2),
-                               char *file,
-                               const int line)
+/**
+ * Writes the input being run to the crash directory, named after its hash.
+ *
+ * @remarks Only uses async-signal-safe functions, so that it is safe to call from a signal handler.
+ * @return The path of the written input or @code NULL @endcode if no input is being run or it could not be written.
+ */
+static const char *fuzz_save_crash(void)
 {
-    if(cmp_fn(unexpected, actual) == 0)
+    const unsigned char *data = fuzzing.data;
+    if(data == NULL)
     {
-        register_fail(file, line, "Assert not equal failed.");
+        return NULL;
     }
-}
+    fuzzing.data = NULL;
 
-void assert_greater_cmp(const void *greater,
-                         const void *lesser,
-                         int(*cmp_fn)(const void *ptr1, const void *ptr2),
-                         char *file,
-                         const int line)
-{
-    if(cmp_fn(greater, lesser) < 1)
+    char *name = fuzzing.crash_path + fuzzing.crash_dir_len;
+    memcpy(name, "/crash-", 7);
+    fuzz_hex(name + 7, xxh64(data, fuzzing.size, 0));
+
+    const int fd = open(fuzzing.crash_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd == -1)
+    {
+        return NULL;
+    }
+    const int written = write_all(fd, data, fuzzing.size);
+    close(fd);
+    if(written != EZTEST_RESULT_OK)
     {
-        register_fail(file, line, "Assert greater failed.");
+        return NULL;
     }
+    return fuzzing.crash_path;
 }
 
-void assert_greater_equal_cmp(const void *ge, 
-                               const void *le, 
-                               int(*cmp_fn)(const void *ptr1, const void *ptr2),
-                               char *file,
-                               const int line)
+/** Saves the crashing input before the AddressSanitizer runtime exits. */
+static void fuzz_on_death(void)
 {
-    if(cmp_fn(ge, le) < 0)
+    const char *path = fuzz_save_crash();
+    if(path != NULL)
     {
-        register_fail(file, line, "Assert greater or equal failed.");
+        static const char msg[] = "Crashing input written to ";
+        write_all(STDERR_FILENO, msg, sizeof(msg) - 1);
+        write_all(STDERR_FILENO, path, strlen(path));
+        write_all(STDERR_FILENO, "\n", 1);
     }
 }
 
-void assert_less_cmp(const void *lesser,
-                      const void *greater,
-                      int(*cmp_fn)(const void *ptr1, const void *ptr2),
-                      char *file,
-                      const int line)
+/** The handlers of the crash signals before fuzzing, in the order of @see fuzz_crash_signals. */
+static struct sigaction fuzz_old_actions[sizeof(fuzz_crash_signals) / sizeof(fuzz_crash_signals[0])];
+
+/** To be executed on a crash signal while fuzzing: saves the input, then raises the signal again for the old handler. */
+static void fuzz_on_crash(const int signum)
 {
-    if(cmp_fn(lesser, greater) >= 0)
+    fuzz_on_death();
+    property_probe = false; // Lets the old handler report the crash, as with --SIGSEGV.
+    for(size_t i = 0; i < sizeof(fuzz_crash_signals) / sizeof(fuzz_crash_signals[0]); i++)
     {
-        register_fail(file, line, "Assert less failed.");
+        if(fuzz_crash_signals[i] == signum)
+        {
+            sigaction(signum, &fuzz_old_actions[i], NULL);
+        }
     }
+    raise(signum);
 }
 
+/** To be executed on SIGINT and SIGTERM while fuzzing. */
+static void fuzz_on_stop(const int signum)
+{
+    (void)signum;
+    fuzzing.stop = 1;
+}
 
-void assert_less_equal_cmp(const void *le,
-                            const void *ge,
-                            int(*cmp_fn)(const void *ptr1, const void *ptr2),
-                            char *file,
-                            const int line)
+/**
+ * Adds an input of the given size to the corpus, the caller fills in its bytes.
+ *
+ * @return The added input or @code NULL @endcode if out of memory.
+ */
+static struct fuzz_input *fuzz_add(struct fuzz_corpus *corpus, const char *path, const size_t size)
 {
-    if(cmp_fn(le, ge) > 0)
+    if(corpus->count == corpus->capacity)
+    {
+        const size_t capacity = corpus->capacity > 0 ? corpus->capacity * 2 : 64;
+        struct fuzz_input *inputs = realloc(corpus->inputs, capacity * sizeof(struct fuzz_input));
+        if(inputs == NULL)
+        {
+            return NULL;
+        }
+        corpus->inputs = inputs;
+        corpus->capacity = capacity;
+    }
+    const size_t path_size = strlen(path) + 1;
+    char *path_copy = arena_alloc(&corpus->arena, path_size);
+    unsigned char *data = arena_alloc(&corpus->arena, size > 0 ? size : 1);
+    if(path_copy == NULL || data == NULL)
     {
-        register_fail(file, line, "Assert less or equal failed.");
+        return NULL;
     }
+    memcpy(path_copy, path, path_size);
+
+    struct fuzz_input *input = &corpus->inputs[corpus->count++];
+    input->path = path_copy;
+    input->data = data;
+    input->size = size;
+    return input;
+}
+
+static int fuzz_compare(const void *a, const void *b)
+{
+    return strcmp(((const struct fuzz_input *)a)->path, ((const struct fuzz_input *)b)->path);
 }
 
-void assert_are_equal_ch(const char expected, const char actual, char *file, const int line)
+/**
+ * Adds each file in the given directory to the corpus. A missing directory adds nothing.
+ *
+ * @param max_size The max amount of bytes read from each file.
+ * @return @code EZTEST_RESULT_OK @endcode on success; otherwise @code EZTEST_RESULT_ERR @endcode
+ *         with errno set.
+ */
+static int fuzz_load(struct fuzz_corpus *corpus, const char *dir, const size_t max_size)
 {
-    if(expected != actual)
+    DIR *stream = opendir(dir);
+    if(stream == NULL)
+    {
+        return errno == ENOENT ? EZTEST_RESULT_OK : EZTEST_RESULT_ERR;
+    }
+
+    int status = EZTEST_RESULT_OK;
+    struct dirent *entry;
+    char path[1024];
+    while(status == EZTEST_RESULT_OK && (entry = readdir(stream)) != NULL)
+    {
+        if(entry->d_name[0] == '.')
+        {
+            continue;
+        }
+        if((size_t)snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name) >= sizeof(path))
+        {
+            errno = ENAMETOOLONG;
+            status = EZTEST_RESULT_ERR;
+            break;
+        }
+
+        const int fd = open(path, O_RDONLY | O_NONBLOCK);
+        if(fd == -1)
+        {
+            status = EZTEST_RESULT_ERR;
+            break;
+        }
+        struct stat st;
+        if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        {
+            close(fd);
+            continue; // Skips directories and other special files.
+        }
+
+        size_t size = (size_t)st.st_size < max_size ? (size_t)st.st_size : max_size;
+        struct fuzz_input *input = fuzz_add(corpus, path, size);
+        if(input == NULL)
+        {
+            errno = ENOMEM;
+            status = EZTEST_RESULT_ERR;
+        }
+        for(size_t done = 0; input != NULL && done < size;)
+        {
+            const ssize_t n = read(fd, input->data + done, size - done);
+            if(n > 0)
+            {
+                done += (size_t)n;
+            }
+            else if(n == 0)
+            {
+                input->size = size = done; // The file was truncated while reading.
+            }
+            else if(errno != EINTR)
+            {
+                status = EZTEST_RESULT_ERR;
+                break;
+            }
+        }
+        close(fd);
+    }
+    closedir(stream);
+
+    if(corpus->count > 1)
     {
-        register_fail(file, line, "Assert are equal failed: expected '%c', but got '%c'.", expected, actual);
+        qsort(corpus->inputs, corpus->count, sizeof(struct fuzz_input), fuzz_compare);
     }
+    return status;
 }
 
-void assert_are_equal_sch(const signed char expected, const signed char actual, char *file, const int line)
+/** Runs the fuzz target with the given input. */
+static void fuzz_execute(void (*target)(const uint8_t *data, size_t len), const unsigned char *data, const size_t size)
 {
-    if(expected != actual)
+    // An exactly sized copy lets the sanitizers catch reads past the end of the input.
+    unsigned char *copy = malloc(size > 0 ? size : 1);
+    if(copy != NULL && size > 0)
     {
-        register_fail(file, line, "Assert are equal failed: expected '%c', but got '%c'.", expected, actual);
+        memcpy(copy, data, size);
     }
+    fuzzing.size = size;
+    fuzzing.data = data;
+    target(copy != NULL ? copy : data, size);
+    fuzzing.data = NULL;
+    free(copy);
+    arena_reset(&test_arena);
+}
+
+/**
+ * Runs the fuzz target with the given input, without reporting failing asserts.
+ *
+ * @return @code true @endcode if an assert failed.
+ */
+static bool fuzz_fails(void (*target)(const uint8_t *data, size_t len), const unsigned char *data, const size_t size)
+{
+    property_failed = false;
+    property_probe = true;
+    fuzz_execute(target, data, size);
+    property_probe = false;
+
+    return property_failed;
 }
 
-void assert_are_equal_uch(const unsigned char expected, const unsigned char actual, char *file, const int line)
+/** The AFL bucket of a hit count, so that only a change in the magnitude of the count is new coverage. */
+static uint8_t fuzz_bucket(const uint8_t hits)
+{
+    return hits < 4   ? (uint8_t)((1u << hits) >> 1)
+         : hits < 8   ? 8
+         : hits < 16  ? 16
+         : hits < 32  ? 32
+         : hits < 128 ? 64
+         : 128;
+}
+
+/**
+ * Adds the counter at the given index to the coverage seen so far and clears it.
+ *
+ * @return @code true @endcode if the counter reached a new bucket.
+ */
+static bool fuzz_cover(const size_t index, uint8_t *seen, size_t *covered)
 {
-    if(expected != actual)
+    const uint8_t bucket = fuzz_bucket(fuzz_counters[index]);
+    fuzz_counters[index] = 0;
+    if((bucket & ~seen[index]) == 0)
     {
-        register_fail(file, line, "Assert are equal failed: expected '%c', but got '%c'.", expected, actual);
+        return false;
     }
+    *covered += seen[index] == 0;
+    seen[index] |= bucket;
+    return true;
 }
 
-void assert_are_equal_int(const intmax_t expected, const intmax_t actual, char *file, const int line)
+/**
+ * Adds the counters of the latest run to the coverage seen so far and clears them.
+ *
+ * @param seen     The buckets of each counter seen so far.
+ * @param covered  Increased by the amount of counters hit for the first time.
+ * @return @code true @endcode if a counter reached a new bucket.
+ */
+static bool fuzz_covers(uint8_t *seen, size_t *covered)
 {
-    if(expected != actual)
+    bool new_coverage = false;
+    if(fuzz_touched_count < EZTEST_FUZZ_MAP_SIZE)
+    {
+        // Only the listed counters were hit, a counter hit again after wrapping around is listed twice.
+        for(size_t i = 0; i < fuzz_touched_count; i++)
+        {
+            new_coverage |= fuzz_cover(fuzz_touched[i], seen, covered);
+        }
+    }
+    else
     {
-        register_fail(file, line, "Assert are equal failed: expected '%ld', but got '%ld'.", expected, actual);
+        for(size_t i = 0; i < EZTEST_FUZZ_MAP_SIZE; i++)
+        {
+            new_coverage |= fuzz_cover(i, seen, covered);
+        }
     }
+    fuzz_touched_count = 0;
+    return new_coverage;
 }
 
-void assert_are_equal_uint(const uintmax_t expected, const uintmax_t actual, char *file, const int line)
+/**
+ * Mutates the given input with a random stack of one to four mutations.
+ *
+ * @param data   The input, with room for EZTEST_FUZZ_MAX_LEN bytes.
+ * @param corpus The corpus spliced from.
+ * @return The new size of the input.
+ */
+static size_t fuzz_mutate(unsigned char *data, size_t size, const struct fuzz_corpus *corpus, uint64_t *rng)
 {
-    if(expected != actual)
+    static const int8_t interesting8[] = { -128, -1, 0, 1, 16, 32, 64, 100, 127 };
+    static const int32_t interesting32[] = { INT32_MIN, -32769, -32768, -129, 128, 255, 256, 512, 1000, 1024,
+                                             4096, 32767, 32768, 65535, 65536, INT32_MAX };
+
+    const int stack = 1 + (int)(property_random(rng) & 3);
+    for(int i = 0; i < stack; i++)
     {
-        register_fail(file, line, "Assert are equal failed: expected '%ld', but got '%ld'.", expected, actual);
+        const uint64_t r = property_random(rng);
+        const size_t at = size > 0 ? (size_t)(r >> 32) % size : 0;
+        int mutation = (int)(r & 0xff) % 9;
+        if(size == 0 && mutation != 8)
+        {
+            mutation = 5; // Only inserting or splicing grows an empty input.
+        }
+        switch(mutation)
+        {
+            case 0: // Flips a bit.
+                data[at] ^= (unsigned char)(1u << ((r >> 8) & 7));
+                break;
+
+            case 1: // Sets a random byte.
+                data[at] = (unsigned char)(r >> 8);
+                break;
+
+            case 2: // Sets an interesting byte.
+                data[at] = (unsigned char)interesting8[((r >> 8) & 0xff) % sizeof(interesting8)];
+                break;
+
+            case 3: // Adds or subtracts a small amount.
+            {
+                const unsigned char delta = (unsigned char)(1 + ((r >> 8) & 0xf));
+                data[at] = (unsigned char)((r & 0x1000) ? data[at] + delta : data[at] - delta);
+                break;
+            }
+
+            case 4: // Sets an interesting 16 or 32 bit value, in either byte order.
+            {
+                const uint32_t value = (uint32_t)interesting32[((r >> 8) & 0xff) % (sizeof(interesting32) / sizeof(interesting32[0]))];
+                const size_t width = (r & 0x10000) ? 4 : 2;
+                if(size < width)
+                {
+                    break;
+                }
+                const size_t pos = at <= size - width ? at : size - width;
+                for(size_t b = 0; b < width; b++)
+                {
+                    const size_t shift = (r & 0x20000) ? 8 * (width - 1 - b) : 8 * b;
+                    data[pos + b] = (unsigned char)(value >> shift);
+                }
+                break;
+            }
+
+            case 5: // Inserts a run of random or repeated bytes.
+            {
+                const size_t pos = size > 0 ? (size_t)(r >> 32) % (size + 1) : 0;
+                size_t n = 1 + ((r >> 8) & 0xf);
+                n = n < EZTEST_FUZZ_MAX_LEN - size ? n : EZTEST_FUZZ_MAX_LEN - size;
+                memmove(data + pos + n, data + pos, size - pos);
+                const uint64_t bytes = property_random(rng);
+                for(size_t b = 0; b < n; b++)
+                {
+                    data[pos + b] = (unsigned char)((r & 0x1000) ? bytes : bytes >> (8 * (b & 7)));
+                }
+                size += n;
+                break;
+            }
+
+            case 6: // Erases a run of bytes.
+            {
+                if(size < 2)
+                {
+                    break;
+                }
+                const size_t max = size - at < 16 ? size - at : 16;
+                const size_t n = 1 + ((r >> 8) & 0xff) % max;
+                memmove(data + at, data + at + n, size - at - n);
+                size -= n;
+                break;
+            }
+
+            case 7: // Copies a run of bytes over another part of the input.
+            {
+                const size_t from = (size_t)(r >> 8) % size;
+                const size_t room = size - (from > at ? from : at);
+                const size_t n = 1 + (size_t)(property_random(rng) % room);
+                memmove(data + at, data + from, n);
+                break;
+            }
+
+            case 8: // Splices a run of bytes from another input of the corpus.
+            {
+                const struct fuzz_input *other = &corpus->inputs[(size_t)(r >> 8) % corpus->count];
+                if(other->size == 0)
+                {
+                    break;
+                }
+                const uint64_t r2 = property_random(rng);
+                const size_t from = (size_t)(r2 >> 32) % other->size;
+                size_t n = 1 + (size_t)(r2 & 0xffffffff) % (other->size - from);
+                n = n < EZTEST_FUZZ_MAX_LEN - at ? n : EZTEST_FUZZ_MAX_LEN - at;
+                memcpy(data + at, other->data + from, n);
+                size = at + n > size ? at + n : size;
+                break;
+            }
+        }
     }
+    return size;
 }
 
 /**
- * Tests the equality of two floating point numbers.
- *
- * @param expected The first and expected value.
- * @param actual   The actual value generated by the code under test.
+ * Writes the path of the directory of the current fuzz test inside the given directory.
  *
- * @remarks It is important to known that this test uses the epsilon macro from float.h
- *          in its equality test. It is therefore often better to use assert_are_equal_precision()
- *          and provide the application specific epsilon.
+ * @return @code EZTEST_RESULT_OK @endcode on success; otherwise @code EZTEST_RESULT_ERR @endcode if the path is too long.
  */
-void assert_are_equal_dbl(const long double expected, const long double actual, char *file, const int line)
+static int fuzz_dir(char *path, const size_t size, const char *dir)
 {
-    if(fabsl(expected - actual) > LDBL_EPSILON)
+    const int len = snprintf(path, size, "%s/%s.%s", dir, current->test_suite, current->test_name);
+    return len >= 0 && (size_t)len < size ? EZTEST_RESULT_OK : EZTEST_RESULT_ERR;
+}
+
+/** Creates the given directory and the directory of the current fuzz test inside it, if they do not exist. */
+static int fuzz_mkdir(char *path, const size_t size, const char *dir)
+{
+    if((mkdir(dir, 0755) != 0 && errno != EEXIST) || fuzz_dir(path, size, dir) != EZTEST_RESULT_OK ||
+       (mkdir(path, 0755) != 0 && errno != EEXIST))
     {
-        register_fail(file, line, "Assert are equal failed: expected '%0.8Lf', but got '%0.8Lf'.", expected, actual);
+        return EZTEST_RESULT_ERR;
     }
+    return EZTEST_RESULT_OK;
 }
-void assert_are_equal_str(const char *expected, const char *actual, char *file, const int line)
+
+/** Prints the progress of fuzzing to stderr, like libFuzzer does. */
+static void fuzz_status(const char *event, const size_t execs, const size_t covered, const size_t inputs,
+                        const struct timespec *start)
 {
-    if((expected == NULL && actual != NULL) ||
-       (expected != NULL && actual == NULL) ||
-       (expected != NULL && strcmp(expected, actual) != 0))
+    if(options->quiet)
     {
-        register_fail(file, line, "Assert are equal failed: expected '%s', but got '%s'.", expected, actual);
+        return;
     }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const double elapsed = (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+    fprintf(stderr, "#%zu\t%s\tcov: %zu corpus: %zu exec/s: %.0f\n",
+            execs, event, covered, inputs, elapsed > 0 ? (double)execs / elapsed : 0);
 }
 
-void assert_are_equal_wstr(const wchar_t *expected, const wchar_t *actual, char *file, const int line)
+/** Runs the fuzz target with each input of its corpus and crash directories. */
+static void fuzz_replay(void (*target)(const uint8_t *data, size_t len), char *file, const int line)
 {
-    if((expected == NULL && actual != NULL) ||
-       (expected != NULL && actual == NULL) ||
-       (expected != NULL && wcscmp(expected, actual) != 0))
+    struct fuzz_corpus corpus = { NULL, 0, 0, { NULL, NULL } };
+    char dir[1024];
+    if(fuzz_dir(dir, sizeof(dir), EZTEST_FUZZ_CORPUS_DIR) != EZTEST_RESULT_OK ||
+       fuzz_load(&corpus, dir, SIZE_MAX) != EZTEST_RESULT_OK ||
+       fuzz_dir(dir, sizeof(dir), EZTEST_FUZZ_CRASH_DIR) != EZTEST_RESULT_OK ||
+       fuzz_load(&corpus, dir, SIZE_MAX) != EZTEST_RESULT_OK)
+    {
+        register_fail(file, line, operand_str, "Fuzz test failed: could not read '%s': %s.", dir, strerror(errno));
+    }
+    else if(corpus.count == 0 && fuzz_add(&corpus, "(empty)", 0) == NULL)
+    {
+        register_fail(file, line, operand_none, "Fuzz test failed: out of memory.");
+    }
+
+    bool failed = result == fail;
+    for(size_t i = 0; i < corpus.count; i++)
+    {
+        result = undefined;
+        fuzz_execute(target, corpus.inputs[i].data, corpus.inputs[i].size);
+        if(result == fail)
+        {
+            failed = true;
+            register_fail(file, line, operand_str, "Fuzz test failed for the input %s%s", corpus.inputs[i].path, ".");
+        }
+    }
+    result = failed ? fail : undefined;
+
+    free(corpus.inputs);
+    arena_free(&corpus.arena);
+}
+
+/** Fuzzes the fuzz target until an input fails, it is stopped or it has run the amount of cases given by --cases. */
+static void fuzz_run(void (*target)(const uint8_t *data, size_t len), char *file, const int line)
+{
+    struct fuzz_corpus corpus = { NULL, 0, 0, { NULL, NULL } };
+    char corpus_dir[1024];
+    if(fuzz_mkdir(corpus_dir, sizeof(corpus_dir), EZTEST_FUZZ_CORPUS_DIR) != EZTEST_RESULT_OK ||
+       fuzz_mkdir(fuzzing.crash_path, sizeof(fuzzing.crash_path) - 24, EZTEST_FUZZ_CRASH_DIR) != EZTEST_RESULT_OK)
+    {
+        register_fail(file, line, operand_str, "Fuzz test failed: could not create the %s directory: %s.",
+                      "corpus or crash", strerror(errno));
+        return;
+    }
+    fuzzing.crash_dir_len = strlen(fuzzing.crash_path);
+    if(fuzz_load(&corpus, corpus_dir, EZTEST_FUZZ_MAX_LEN) != EZTEST_RESULT_OK)
+    {
+        register_fail(file, line, operand_str, "Fuzz test failed: could not read '%s': %s.", corpus_dir, strerror(errno));
+        free(corpus.inputs);
+        arena_free(&corpus.arena);
+        return;
+    }
+
+    unsigned char *input = malloc(EZTEST_FUZZ_MAX_LEN);
+    uint8_t *seen = calloc(EZTEST_FUZZ_MAP_SIZE, 1);
+    if(input == NULL || seen == NULL || (corpus.count == 0 && fuzz_add(&corpus, "(empty)", 0) == NULL))
+    {
+        register_fail(file, line, operand_none, "Fuzz test failed: out of memory.");
+        free(input);
+        free(seen);
+        free(corpus.inputs);
+        arena_free(&corpus.arena);
+        return;
+    }
+
+    struct sigaction action, old_int, old_term;
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_handler = fuzz_on_crash;
+    for(size_t i = 0; i < sizeof(fuzz_crash_signals) / sizeof(fuzz_crash_signals[0]); i++)
+    {
+        sigaction(fuzz_crash_signals[i], &action, &fuzz_old_actions[i]);
+    }
+    action.sa_handler = fuzz_on_stop;
+    sigaction(SIGINT, &action, &old_int);
+    sigaction(SIGTERM, &action, &old_term);
+    if(__sanitizer_set_death_callback != NULL)
+    {
+        __sanitizer_set_death_callback(fuzz_on_death);
+    }
+    fuzzing.stop = 0;
+
+    // Each fuzz test gets its own sequence, so that a run replays the same with --seed.
+    uint64_t rng = xxh64(current->test_name, strlen(current->test_name),
+                         xxh64(current->test_suite, strlen(current->test_suite), property_seed));
+    const size_t max_execs = options->property_cases > 0 ? options->property_cases : SIZE_MAX;
+    size_t execs = 0, covered = 0, size = 0;
+    const char *failing = NULL;
+    bool found = false;
+    struct timespec start, last;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    last = start;
+    memset(fuzz_counters, 0, sizeof(fuzz_counters));
+    fuzz_touched_count = 0;
+
+    if(!options->quiet)
+    {
+        fprintf(stderr, "Fuzzing %s.%s with seed %" PRIu64 ", replay with --seed=%" PRIu64 ".\n",
+                current->test_suite, current->test_name, property_seed, property_seed);
+    }
+    for(size_t i = 0; i < corpus.count && failing == NULL; i++)
+    {
+        if(fuzz_fails(target, corpus.inputs[i].data, corpus.inputs[i].size))
+        {
+            failing = corpus.inputs[i].path;
+            size = corpus.inputs[i].size;
+            memcpy(input, corpus.inputs[i].data, size);
+        }
+        fuzz_covers(seen, &covered);
+        execs++;
+    }
+    fuzz_status("INITED", execs, covered, corpus.count, &start);
+
+    while(failing == NULL && execs < max_execs && !fuzzing.stop)
+    {
+        const struct fuzz_input *parent = &corpus.inputs[(size_t)(property_random(&rng) % corpus.count)];
+        memcpy(input, parent->data, parent->size);
+        size = fuzz_mutate(input, parent->size, &corpus, &rng);
+        const bool fails = fuzz_fails(target, input, size);
+        execs++;
+        if(fails)
+        {
+            fuzzing.data = input;
+            fuzzing.size = size;
+            failing = fuzz_save_crash();
+            found = true;
+            if(failing == NULL)
+            {
+                failing = "(could not be written)";
+            }
+            fuzz_covers(seen, &covered);
+        }
+        else if(fuzz_covers(seen, &covered))
+        {
+            char path[sizeof(corpus_dir) + 18];
+            const int len = snprintf(path, sizeof(path), "%s/", corpus_dir);
+            fuzz_hex(path + len, xxh64(input, size, 0));
+            struct fuzz_input *added = fuzz_add(&corpus, path, size);
+            if(added != NULL)
+            {
+                memcpy(added->data, input, size);
+                replace_file(path, input, size, 0644);
+                fuzz_status("NEW", execs, covered, corpus.count, &start);
+            }
+        }
+        if((execs & 0xfff) == 0)
+        {
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if(now.tv_sec > last.tv_sec)
+            {
+                last = now;
+                fuzz_status("PULSE", execs, covered, corpus.count, &start);
+            }
+        }
+    }
+    fuzz_status("DONE", execs, covered, corpus.count, &start);
+
+    if(__sanitizer_set_death_callback != NULL)
+    {
+        __sanitizer_set_death_callback(NULL);
+    }
+    sigaction(SIGINT, &old_int, NULL);
+    sigaction(SIGTERM, &old_term, NULL);
+    for(size_t i = 0; i < sizeof(fuzz_crash_signals) / sizeof(fuzz_crash_signals[0]); i++)
+    {
+        sigaction(fuzz_crash_signals[i], &fuzz_old_actions[i], NULL);
+    }
+
+    if(failing != NULL)
     {
-        register_fail(file, line, "Assert are equal failed: expected '%ls', but got '%ls'.", expected, actual);
+        fuzz_execute(target, input, size); // Reports the failing asserts of the input.
+        char summary[128];
+        if(found)
+        {
+            snprintf(summary, sizeof(summary), "found a failing input after %zu runs, written to ", execs);
+        }
+        else
+        {
+            snprintf(summary, sizeof(summary), "the corpus has the failing input ");
+        }
+        register_fail(file, line, operand_str, "Fuzz test failed: %s%s.", summary, failing);
     }
-}
 
-/** Triggered when attempting to compare using an unsupported data type. */
-void assert_are_equal(const void *expected, const void *actual, char *file, const int line)
-{
-    register_fail(file, line, "Assert are equal failed: unsupported data type.");
+    free(input);
+    free(seen);
+    free(corpus.inputs);
+    arena_free(&corpus.arena);
 }
 
-void assert_are_not_equal_ch(const char unexpected, const char actual, char *file, const int line)
+void eztest_fuzz(void (*target)(const uint8_t *data, size_t len), char *file, const int line)
 {
-    if(unexpected == actual)
+    if(options->fuzz == NULL)
     {
-        register_fail(file, line, "Assert not equal failed: '%c' and '%c' are equal.", unexpected, actual);
+        fuzz_replay(target, file, line);
     }
-}
-
-void assert_are_not_equal_sch(const signed char unexpected, const signed char actual, char *file, const int line)
-{
-    if(unexpected == actual)
+    else
     {
-        register_fail(file, line, "Assert not equal failed: '%c' and '%c' are equal.", unexpected, actual);
+        fuzz_run(target, file, line);
     }
 }
 
-void assert_are_not_equal_uch(const unsigned char unexpected, const unsigned char actual, char *file, const int line)
+//endregion fuzzing
+
+//region data tests
+
+/** The C locale, so that numbers in data files are parsed the same whatever the locale of the runner. */
+static locale_t data_locale = (locale_t)0;
+
+/**
+ * Copies the given field to the given buffer as a NUL terminated string.
+ *
+ * @return @code true @endcode if the field is not empty and fits in the buffer.
+ */
+static bool field_copy(const struct eztest_field *field, char *buffer, const size_t size)
 {
-    if(unexpected == actual)
+    if(field == NULL || field->size == 0 || field->size >= size)
     {
-        register_fail(file, line, "Assert not equal failed: '%c' and '%c' are equal.", unexpected, actual);
+        return false;
     }
+    memcpy(buffer, field->data, field->size);
+    buffer[field->size] = '\0';
+    return true;
 }
 
-void assert_are_not_equal_int(const intmax_t unexpected, const intmax_t actual, char *file, const int line)
+bool eztest_field_int(const struct eztest_field *field, long long *value)
 {
-    if(unexpected == actual)
+    char buffer[72];
+    if(value == NULL || !field_copy(field, buffer, sizeof(buffer)))
     {
-        register_fail(file, line, "Assert not equal failed: '%ld' and '%ld' are equal.", unexpected, actual);
+        return false;
     }
+    char *end;
+    errno = 0;
+    *value = strtoll(buffer, &end, 0);
+    return *end == '\0' && errno == 0;
 }
 
-void assert_are_not_equal_uint(const uintmax_t unexpected, const uintmax_t actual, char *file, const int line)
+bool eztest_field_float(const struct eztest_field *field, double *value)
 {
-    if(unexpected == actual)
+    char buffer[512];
+    if(value == NULL || !field_copy(field, buffer, sizeof(buffer)))
+    {
+        return false;
+    }
+    if(data_locale == (locale_t)0)
     {
-        register_fail(file, line, "Assert not equal failed: '%ld' and '%ld' are equal.", unexpected, actual);
+        data_locale = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
     }
+    const locale_t old = data_locale != (locale_t)0 ? uselocale(data_locale) : (locale_t)0;
+    char *end;
+    errno = 0;
+    *value = strtod(buffer, &end);
+    const bool valid = *end == '\0' && errno == 0;
+    if(old != (locale_t)0)
+    {
+        uselocale(old);
+    }
+    return valid;
 }
 
 /**
- * Tests the equality of two floating point numbers.
- *
- * @param unexpected The first and unexpected value.
- * @param actual     The actual value generated by the code under test.
+ * Maps the given data file for reading, @code NULL @endcode for an empty file.
  *
- * @remarks It is important to known that this test uses the epsilon macro from float.h
- *          in its equality test. It is therefore often better to use assert_are_equal_precision()
- *          and provide the application specific epsilon.
+ * @return @code EZTEST_RESULT_OK @endcode on success; otherwise @code EZTEST_RESULT_ERR @endcode
+ *         with errno set.
  */
-void assert_are_not_equal_dbl(const long double unexpected, const long double actual, char *file, const int line)
+static int data_map(const char *path, const char **data, size_t *size)
 {
-    if(fabsl(unexpected - actual) <= LDBL_EPSILON)
+    struct stat st;
+    const int fd = open(path, O_RDONLY);
+    if(fd == -1 || fstat(fd, &st) != 0)
+    {
+        const int err = errno;
+        if(fd != -1) close(fd);
+        errno = err;
+        return EZTEST_RESULT_ERR;
+    }
+
+    *size = (size_t)st.st_size;
+    *data = NULL;
+    if(*size > 0)
     {
-        register_fail(file, line, "Assert not equal failed: '%0.8Lf' and '%0.8Lf' are equal.", unexpected, actual);
+        void *mapping = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapping == MAP_FAILED)
+        {
+            const int err = errno;
+            close(fd);
+            errno = err;
+            return EZTEST_RESULT_ERR;
+        }
+        madvise(mapping, *size, MADV_SEQUENTIAL);
+        *data = mapping;
     }
+    close(fd);
+    return EZTEST_RESULT_OK;
 }
 
-void assert_are_not_equal_str(const char *unexpected, const char *actual, char *file, const int line)
+/**
+ * Releases the pages of the mapping read so far once a chunk of them has been read,
+ * so that a large data file is not kept in memory while it is read.
+ *
+ * @param released The amount of bytes released so far, updated by this function.
+ * @param done     The amount of bytes read so far.
+ */
+static void data_release(const char *data, size_t *released, const size_t done)
 {
-    if((unexpected == NULL && actual == NULL) ||
-       (unexpected != NULL && actual != NULL && strcmp(unexpected, actual) == 0))
+    if(done - *released < EZTEST_DATA_CHUNK)
     {
-        register_fail(file, line, "Assert not equal failed: '%s' and '%s' are equal.", unexpected, actual);
+        return;
     }
+    const size_t end = done & ~((size_t)sysconf(_SC_PAGESIZE) - 1);
+    madvise((void *)(data + *released), end - *released, MADV_DONTNEED);
+    *released = end;
 }
 
-void assert_are_not_equal_wstr(const wchar_t *unexpected, const wchar_t *actual, char *file, const int line)
+/**
+ * Splits the given line into its fields. The fields point into the line, except for quoted fields
+ * holding doubled quotes, which are unescaped into the given buffer.
+ *
+ * @param fields   The array of fields, grown by this function when needed.
+ * @param capacity The capacity of the array of fields.
+ * @param unescaped The buffer of the unescaped fields of the line, grown by this function to the
+ *                  length of the line when needed, so that it is not moved while the row runs.
+ * @param unescaped_capacity The capacity of the buffer of the unescaped fields.
+ * @return The amount of fields or 0 (zero) if out of memory.
+ */
+static size_t data_split(const char *line, const size_t len, struct eztest_field **fields, size_t *capacity,
+                         char **unescaped, size_t *unescaped_capacity)
 {
-    if((unexpected == NULL && actual == NULL) ||
-       (unexpected != NULL && actual != NULL && wcscmp(unexpected, actual) == 0))
+    size_t count = 0, used = 0;
+    for(size_t pos = 0;; pos++)
     {
-        register_fail(file, line, "Assert not equal failed: '%ls' and '%ls' are equal.", unexpected, actual);
+        if(count == *capacity)
+        {
+            const size_t new_capacity = *capacity > 0 ? *capacity * 2 : 16;
+            struct eztest_field *grown = realloc(*fields, new_capacity * sizeof(struct eztest_field));
+            if(grown == NULL)
+            {
+                return 0;
+            }
+            *fields = grown;
+            *capacity = new_capacity;
+        }
+
+        struct eztest_field *field = &(*fields)[count++];
+        if(pos < len && line[pos] == '"')
+        {
+            // The field ends at the first quote that is not doubled.
+            const size_t start = ++pos;
+            bool doubled = false;
+            while(pos < len && (line[pos] != '"' || (pos + 1 < len && line[pos + 1] == '"')))
+            {
+                doubled |= line[pos] == '"';
+                pos += line[pos] == '"' ? 2 : 1;
+            }
+            field->data = line + start;
+            field->size = (pos < len ? pos : len) - start;
+            if(doubled)
+            {
+                if(*unescaped_capacity < len)
+                {
+                    // No field of this line points into the buffer yet, as the first unescaped field grows it.
+                    char *grown = realloc(*unescaped, len);
+                    if(grown == NULL)
+                    {
+                        return 0;
+                    }
+                    *unescaped = grown;
+                    *unescaped_capacity = len;
+                }
+                char *copy = *unescaped + used;
+                size_t size = 0;
+                for(size_t i = 0; i < field->size; i++)
+                {
+                    copy[size++] = field->data[i];
+                    i += field->data[i] == '"';
+                }
+                field->data = copy;
+                field->size = size;
+                used += size;
+            }
+            const char *comma = pos < len ? memchr(line + pos, ',', len - pos) : NULL;
+            pos = comma != NULL ? (size_t)(comma - line) : len;
+        }
+        else
+        {
+            const char *comma = pos < len ? memchr(line + pos, ',', len - pos) : NULL;
+            const size_t end = comma != NULL ? (size_t)(comma - line) : len;
+            field->data = line + pos;
+            field->size = end - pos;
+            pos = end;
+        }
+        if(pos >= len)
+        {
+            return count;
+        }
     }
 }
 
-/** Triggered when attempting to compare using an unsupported data type. */
-void assert_are_not_equal(const void *expected, const void *actual, char *file, const int line)
+/** Counts the rows, or records, of a data test that failed. */
+struct data_failures
 {
-    register_fail(file, line, "Assert not equal failed: unsupported data type.");
-}
+    /** Whether the test had failed before its rows were run. */
+    bool before;
+    size_t count;
+    /** The line, or index, of the first failed row. */
+    size_t first;
+};
 
-void assert_are_equal_precision(const long double  expected,
-                                 const long double  actual,
-                                 const long double  epsilon,
-                                 char              *file,
-                                 const int          line)
+/** Runs a row of a data test, counting it if it fails. */
+#define DATA_RUN_ROW(failures, number, run)\
+    do {\
+        result = undefined;\
+        run;\
+        arena_reset(&test_arena);\
+        if(result == fail && (failures).count++ == 0)\
+        {\
+            (failures).first = (number);\
+        }\
+    } while(0)
+
+/**
+ * Sets the result of the data test and reports the failed rows.
+ *
+ * @param unit     What a row is called, like "rows".
+ * @param position How the first failed row is located, like "on line".
+ */
+static void data_report(const struct data_failures *failures, const char *unit, const char *position,
+                        const size_t total, const char *path, char *file, const int line)
 {
-    if(fabsl(expected - actual) > epsilon)
+    result = failures->before || failures->count > 0 ? fail : undefined;
+    if(failures->count > 0)
     {
-        register_fail(file, line, "Assert are equal failed: expected '%0.8Lf', but got '%0.8Lf'.", expected, actual);
+        char summary[160];
+        snprintf(summary, sizeof(summary), "%zu of %zu %s failed, the first %s %zu of ",
+                 failures->count, total, unit, position, failures->first);
+        register_fail(file, line, operand_str, "Data test failed: %s'%s'.", summary, path);
     }
 }
 
-void assert_are_not_equal_precision(const long double  unexpected,
-                                     const long double  actual,
-                                     const long double  epsilon,
-                                     char              *file,
-                                     const int          line)
+void eztest_data(const char *path, void (*test)(const struct eztest_row *row), char *file, const int line)
 {
-    if(fabsl(unexpected - actual) <= epsilon)
+    const char *data;
+    size_t size;
+    if(data_map(path, &data, &size) != EZTEST_RESULT_OK)
     {
-        register_fail(file, line, "Assert not equal failed: '%0.8Lf' and '%0.8Lf' are equal.", unexpected, actual);
+        register_fail(file, line, operand_str, "Data test failed: could not open '%s': %s.", path, strerror(errno));
+        return;
     }
-}
 
-void assert_greater_ch(const char greater, const char lesser, char *file, const int line)
-{
-    if(greater <= lesser)
+    struct eztest_field *fields = NULL;
+    char *unescaped = NULL;
+    size_t capacity = 0, unescaped_capacity = 0, rows = 0, number = 0, released = 0;
+    struct data_failures failures = { result == fail, 0, 0 };
+    for(size_t pos = 0; pos < size;)
     {
-        register_fail(file, line, "Assert greater failed: '%c' is not greater than '%c'.", greater, lesser);
+        const char *begin = data + pos;
+        const char *newline = memchr(begin, '\n', size - pos);
+        size_t len = newline != NULL ? (size_t)(newline - begin) : size - pos;
+        pos += len + (newline != NULL);
+        number++;
+        if(len > 0 && begin[len - 1] == '\r')
+        {
+            len--;
+        }
+        if(len == 0 || begin[0] == '#')
+        {
+            continue;
+        }
+
+        const size_t count = data_split(begin, len, &fields, &capacity, &unescaped, &unescaped_capacity);
+        if(count == 0)
+        {
+            register_fail(file, line, operand_none, "Data test failed: out of memory.");
+            failures.before = true;
+            break;
+        }
+        const struct eztest_row row = { number, count, fields };
+        DATA_RUN_ROW(failures, number, test(&row));
+        rows++;
+        data_release(data, &released, pos);
     }
-}
+    data_report(&failures, "rows", "on line", rows, path, file, line);
 
-void assert_greater_sch(const signed char greater, const signed char lesser, char *file, const int line)
-{
-    if(greater <= lesser)
+    free(fields);
+    free(unescaped);
+    if(data != NULL)
     {
-        register_fail(file, line, "Assert greater failed: '%c' is not greater than '%c'.", greater, lesser);
+        munmap((void *)data, size);
     }
 }
 
-void assert_greater_uch(const unsigned char greater, const unsigned char lesser, char *file, const int line)
+void eztest_data_records(const char *path, const size_t size, void (*test)(const void *record), char *file, const int line)
 {
-    if(greater <= lesser)
+    const char *data;
+    size_t file_size;
+    if(data_map(path, &data, &file_size) != EZTEST_RESULT_OK)
     {
-        register_fail(file, line, "Assert greater failed: '%c' is not greater than '%c'.", greater, lesser);
+        register_fail(file, line, operand_str, "Data test failed: could not open '%s': %s.", path, strerror(errno));
+        return;
+    }
+    if(file_size % size != 0)
+    {
+        register_fail(file, line, operand_str, "Data test failed: the size of '%s' is not a multiple of %s.",
+                      path, "the record size");
+        munmap((void *)data, file_size);
+        return;
     }
-}
 
-void assert_greater_int(const intmax_t greater, const intmax_t lesser, char *file, const int line)
-{
-    if(greater <= lesser)
+    const size_t count = file_size / size;
+    size_t released = 0;
+    struct data_failures failures = { result == fail, 0, 0 };
+    for(size_t i = 0; i < count; i++)
     {
-        register_fail(file, line, "Assert greater failed: '%ld' is not greater than '%ld'.", greater, lesser);
+        DATA_RUN_ROW(failures, i, test(data + i * size));
+        data_release(data, &released, (i + 1) * size);
     }
-}
+    data_report(&failures, "records", "at index", count, path, file, line);
 
-void assert_greater_uint(const uintmax_t greater, const uintmax_t lesser, char *file, const int line)
-{
-    if(greater <= lesser)
+    if(data != NULL)
     {
-        register_fail(file, line, "Assert greater failed: '%ld' is not greater than '%ld'.", greater, lesser);
+        munmap((void *)data, file_size);
     }
 }
 
+//endregion data tests
+
+//region runner
+
 /**
- * Tests the equality of two floating point numbers.
- *
- * @param greater The value that is expected to be greater.
- * @param lesser  The value that is expected to be lesser.
+ * Discovers the unit test starting at the given address.
  *
- * @remarks It is important to known that this test uses the epsilon macro from float.h
- *          in its equality test. It is therefore often better to use assert_greater_precision()
- *          and provide the application specific epsilon.
+ * @param base_test the starting address of which to start the discovery.
+ * @return the amount of tests found.
  */
-void assert_greater_dbl(const long double greater, const long double lesser, char *file, const int line)
+static int discover(struct unit_test **base_test)
 {
-    if(fabsl(greater - lesser) <= LDBL_EPSILON || greater < lesser)
+    int count = 0;
+    struct unit_test *tmp = *base_test;
+
+    while(true)
     {
-        register_fail(file, line, "Assert greater failed: '%0.8Lf' is not greater than '%0.8Lf'.", greater, lesser);
+        if(tmp->marker == EZTEST_MARKER)
+        {
+            if(strcmp(tmp->test_name, EZTEST_BASE_TEST_NAME) == 0)
+            {
+                (*base_test)++;
+                tmp++;
+                continue;
+            }
+            tmp++;
+            count++;
+        }
+        else
+        {
+            break;
+        }
     }
+    return count;
 }
-void assert_greater_str(const char *greater, const char *lesser, char *file, const int line)
+
+static bool should_skip(const struct unit_test *test)
 {
-    if((greater == NULL && lesser != NULL) ||
-       (greater == NULL && lesser == NULL) ||
-       (greater != NULL && lesser != NULL && strcmp(greater, lesser) <= 0))
+    if(options->fuzz != NULL)
     {
-        register_fail(file, line, "Assert greater failed: '%s' is not greater than '%s'.", greater, lesser);
+        // Only the fuzzed test is run, given as suite.name.
+        const size_t suite_len = strlen(test->test_suite);
+        return strncmp(options->fuzz, test->test_suite, suite_len) != 0 || options->fuzz[suite_len] != '.' ||
+               strcmp(options->fuzz + suite_len + 1, test->test_name) != 0;
     }
-}
-
-void assert_greater_wstr(const wchar_t *greater, const wchar_t *lesser, char *file, const int line)
-{
-    if((greater == NULL && lesser != NULL) ||
-       (greater == NULL && lesser == NULL) ||
-       (greater != NULL && lesser != NULL && wcscmp(greater, lesser) <= 0))
+    if(!options->skip || skip_list == NULL)
+    {
+        return false;
+    }
+    char *skip_list_cp = malloc((strlen(skip_list) + 1) * sizeof(char));
+    if(skip_list_cp == NULL)
+    {
+        return false;
+    }
+    strcpy(skip_list_cp, skip_list);
+ 
+    char *token;
+    token = strtok(skip_list_cp, separator);
+    while(token != NULL)
     {
-        register_fail(file, line, "Assert greater failed: '%ls' is not greater than '%ls'.", greater, lesser);
+        if(strcmp(token, test->test_suite) == 0)
+        {
+            free(skip_list_cp);
+            return true;
+        }
+        token = strtok(NULL, separator);
     }
+    free(skip_list_cp);
+
+    return false;
 }
 
-/** Triggered when attempting to compare using an unsupported data type. */
-void assert_greater(const void *greater, const void *lesser, char *file, const int line)
+/** A mapping allocated by eztest_shared_alloc, the memory is placed after this header. */
+struct shared_region
 {
-    register_fail(file, line, "Assert greater failed: unsupported data type.");
-}
+    struct shared_region *next;
+    /** The size of the whole mapping, including this header. */
+    size_t size;
+};
 
-void assert_greater_precision(const long double   greater,
-                               const long double   lesser,
-                               const long double   epsilon,
-                               char              * file,
-                               const int           line)
+/** The size of the header of a shared region, keeping the memory after it aligned. */
+#define EZTEST_SHARED_HEADER_SIZE 64
+
+/** The environment setup and teardown functions and the memory they share with the tests. */
+static struct
 {
-    if(fabsl(greater - lesser) <= epsilon || greater < lesser)
+    void (**setup_fns)();
+    void (**teardown_fns)();
+    int setup_count;
+    int teardown_count;
+    /** Whether the environment setup functions are running, shared memory is only allocated then. */
+    bool building;
+    struct shared_region *regions;
+} environment = { NULL, NULL, 0, 0, false, NULL };
+
+void *eztest_shared_alloc(const size_t size)
+{
+    if(!environment.building || size > SIZE_MAX - EZTEST_SHARED_HEADER_SIZE)
     {
-        register_fail(file, line, "Assert greater failed: '%0.8Lf' is not greater than '%0.8Lf'.", greater, lesser);
+        return NULL;
     }
-}
-
-void assert_greater_equal_ch(const char ge, const char le, char *file, const int line)
-{
-    if(ge < le)
+    const size_t total = size + EZTEST_SHARED_HEADER_SIZE;
+    struct shared_region *region = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(region == MAP_FAILED)
     {
-        register_fail(file, line, "Assert greater or equal failed: '%c' is lesser than '%c'.", ge, le);
+        return NULL;
     }
+    region->next = environment.regions;
+    region->size = total;
+    environment.regions = region;
+    return (char *)region + EZTEST_SHARED_HEADER_SIZE;
 }
 
-void assert_greater_equal_sch (const signed char ge, const signed char le, char *file, const int line)
+/** Runs the environment setup functions and makes the memory they allocated read-only. */
+static void environment_setup(void)
 {
-    if(ge < le)
+    environment.building = true;
+    for(int i = 0; i < environment.setup_count; i++)
     {
-        register_fail(file, line, "Assert greater or equal failed: '%c' is lesser than '%c'.", ge, le);
+        environment.setup_fns[i]();
     }
-}
-
-void assert_greater_equal_uch (const unsigned char ge, const unsigned char le, char *file, const int line)
-{
-    if(ge < le)
+    environment.building = false;
+    for(struct shared_region *region = environment.regions; region != NULL; region = region->next)
     {
-        register_fail(file, line, "Assert greater or equal failed: '%c' is lesser than '%c'.", ge, le);
+        mprotect(region, region->size, PROT_READ);
     }
 }
 
-void assert_greater_equal_int (const intmax_t ge, const intmax_t le, char *file, const int line)
+/** Runs the environment teardown functions in reverse order and unmaps the shared memory. */
+static void environment_teardown(void)
 {
-    if(ge < le)
+    for(int i = environment.teardown_count; i > 0; i--)
+    {
+        environment.teardown_fns[i - 1]();
+    }
+    while(environment.regions != NULL)
     {
-        register_fail(file, line, "Assert greater or equal failed: '%ld' is lesser than '%ld'.", ge, le);
+        struct shared_region *region = environment.regions;
+        environment.regions = region->next;
+        munmap(region, region->size);
     }
 }
 
-void assert_greater_equal_uint(const uintmax_t ge, const uintmax_t le, char *file, const int line)
+/** A test in the order it is run, with the suite hooks that run around it. */
+struct planned_test
+{
+    struct unit_test *test;
+    /** The suite setup function, only set for the first test of the suite that is run. */
+    void (*setup_suite_fn)();
+    /** The suite teardown function, only set for the last test of the suite that is run. */
+    void (*teardown_suite_fn)();
+    /** The snapshot setup function, only set for the first test of the suite that is run. */
+    void (*snapshot_setup_fn)();
+    /** Whether the test runs in a forked process, set for each test of a suite with a snapshot setup. */
+    bool forked;
+    /** Whether the environment is set up before the test, only set for the first test that is run. */
+    bool setup_environment;
+    /** Whether the environment is torn down after the test, only set for the last test that is run. */
+    bool teardown_environment;
+    bool skip;
+};
+
+/** A suite while planning the run. */
+struct planned_suite
 {
-    if(ge < le)
+    const char *name;
+    void (*setup_suite_fn)();
+    void (*teardown_suite_fn)();
+    void (*snapshot_setup_fn)();
+    /** The amount of tests in the suite. */
+    int count;
+    /** The position of the next test of the suite in the plan. */
+    int next;
+};
+
+/**
+ * Finds the given suite of the plan, adding the suite if it has not been seen before.
+ *
+ * @return The index of the suite or -1 if out of memory.
+ */
+static int find_planned_suite(struct planned_suite **suites, int *count, int *cap, const char *name)
+{
+    // Tests of the same suite are usually defined one after the other.
+    for(int i = *count; i > 0; i--)
+    {
+        if(strcmp((*suites)[i - 1].name, name) == 0)
+        {
+            return i - 1;
+        }
+    }
+    if(*count == *cap)
     {
-        register_fail(file, line, "Assert greater or equal failed: '%ld' is lesser than '%ld'.", ge, le);
+        const int new_cap = *cap == 0 ? 16 : 2 * *cap;
+        struct planned_suite *tmp = realloc(*suites, new_cap * sizeof(struct planned_suite));
+        if(tmp == NULL)
+        {
+            return -1;
+        }
+        *suites = tmp;
+        *cap = new_cap;
     }
+    (*suites)[*count] = (struct planned_suite){ .name = name };
+    return (*count)++;
 }
 
 /**
- * Tests the equality of two floating point numbers.
+ * Plans the run of the discovered tests. The tests are grouped by suite, in the order the
+ * suites and the tests are defined, so that the suite setup and teardown functions run once
+ * for each suite. They are attached to the first and last test of the suite that is not skipped,
+ * like the environment is to the first and last test of the run.
  *
- * @param ge The value that is expected to be greater or equal to the second value.
- * @param le  The value that is expected to be less than or equal to the first value.
- *
- * @remarks It is important to known that this test uses the epsilon macro from float.h
- *          in its equality test. It is therefore often better to use assert_greater_equal_precision()
- *          and provide the application specific epsilon.
+ * @param base    The first discovered entry.
+ * @param count   The amount of discovered entries, including the setup and teardown functions.
+ * @param planned Set to the planned tests, to be freed by the caller.
+ * @return The amount of planned tests or -1 if out of memory.
  */
-void assert_greater_equal_dbl(const long double ge, const long double le, char *file, const int line)
+static int plan(struct unit_test *base, const int count, struct planned_test **planned)
 {
-    if(fabsl(ge - le) > LDBL_EPSILON && ge < le)
+    struct planned_suite *suites = NULL;
+    int suite_count = 0, suite_cap = 0, test_count = 0;
+    int *suite_of = malloc((count > 0 ? count : 1) * sizeof(int));
+    *planned = NULL;
+    environment.setup_fns = malloc((count > 0 ? count : 1) * sizeof(void (*)()));
+    environment.teardown_fns = malloc((count > 0 ? count : 1) * sizeof(void (*)()));
+    if(suite_of == NULL || environment.setup_fns == NULL || environment.teardown_fns == NULL)
     {
-        register_fail(file, line, "Assert greater or equal failed: '%0.8Lf' is lesser than '%0.8Lf'.", ge, le);
+        goto error;
     }
-}
 
-void assert_greater_equal_str(const char *ge, const char *le, char *file, const int line)
-{
-    if((ge == NULL && le != NULL) ||
-       (ge != NULL && le != NULL && strcmp(ge, le) < 0))
+    for(int i = 0; i < count; i++)
+    {
+        if(strcmp(base[i].test_name, EZTEST_ENVIRONMENT_SETUP_NAME) == 0)
+        {
+            environment.setup_fns[environment.setup_count++] = base[i].run_fn;
+            suite_of[i] = -1;
+            continue;
+        }
+        if(strcmp(base[i].test_name, EZTEST_ENVIRONMENT_TEARDOWN_NAME) == 0)
+        {
+            environment.teardown_fns[environment.teardown_count++] = base[i].run_fn;
+            suite_of[i] = -1;
+            continue;
+        }
+        const int suite = find_planned_suite(&suites, &suite_count, &suite_cap, base[i].test_suite);
+        if(suite < 0)
+        {
+            goto error;
+        }
+        suite_of[i] = suite;
+        if(strcmp(base[i].test_name, EZTEST_SETUP_SUITE_NAME) == 0)
+        {
+            suites[suite].setup_suite_fn = base[i].run_fn;
+        }
+        else if(strcmp(base[i].test_name, EZTEST_TEARDOWN_SUITE_NAME) == 0)
+        {
+            suites[suite].teardown_suite_fn = base[i].run_fn;
+        }
+        else if(strcmp(base[i].test_name, EZTEST_SNAPSHOT_SETUP_NAME) == 0)
+        {
+            suites[suite].snapshot_setup_fn = base[i].run_fn;
+        }
+        else
+        {
+            const int instances = base[i].run_param_fn != NULL ? (int)base[i].param_count : 1;
+            suites[suite].count += instances;
+            test_count += instances;
+        }
+    }
+
+    *planned = malloc((test_count > 0 ? test_count : 1) * sizeof(struct planned_test));
+    if(*planned == NULL)
     {
-        register_fail(file, line, "Assert greater or equal failed: '%s' is lesser than '%s'.", ge, le);
+        goto error;
     }
-}
 
-void assert_greater_equal_wstr(const wchar_t *ge, const wchar_t *le, char *file, const int line)
-{
-    if((ge == NULL && le != NULL) ||
-       (ge != NULL && le != NULL && wcscmp(ge, le) < 0))
+    // Each suite gets the positions following the previous suite, keeping the order of its tests.
+    for(int i = 0, next = 0; i < suite_count; i++)
     {
-        register_fail(file, line, "Assert greater or equal failed: '%ls' is lesser than '%ls'.", ge, le);
+        suites[i].next = next;
+        next += suites[i].count;
+    }
+    for(int i = 0; i < count; i++)
+    {
+        if(suite_of[i] < 0 || strcmp(base[i].test_name, EZTEST_SETUP_SUITE_NAME) == 0
+           || strcmp(base[i].test_name, EZTEST_TEARDOWN_SUITE_NAME) == 0
+           || strcmp(base[i].test_name, EZTEST_SNAPSHOT_SETUP_NAME) == 0)
+        {
+            continue;
+        }
+        struct planned_suite *suite = &suites[suite_of[i]];
+        const size_t instances = base[i].run_param_fn != NULL ? base[i].param_count : 1;
+        for(size_t row = 0; row < instances; row++)
+        {
+            struct unit_test *test = &base[i];
+            if(base[i].run_param_fn != NULL)
+            {
+                // Each row is run as a copy of the registered test, named after the row.
+                const size_t name_size = strlen(base[i].test_name) + 22;
+                test = arena_alloc(&plan_arena, sizeof(struct unit_test));
+                char *name = arena_alloc(&plan_arena, name_size);
+                if(test == NULL || name == NULL)
+                {
+                    goto error;
+                }
+                snprintf(name, name_size, "%s/%zu", base[i].test_name, row);
+                *test = base[i];
+                test->test_name   = name;
+                test->params      = (const char *)base[i].params + row * base[i].param_size;
+                test->param_count = 1;
+            }
+            (*planned)[suite->next++] = (struct planned_test){
+                .test   = test,
+                .forked = suite->snapshot_setup_fn != NULL,
+                .skip   = should_skip(test)
+            };
+        }
     }
-}
-void assert_greater_equal(const void *ge, const void *le, char *file, const int line)
-{
-    register_fail(file, line, "Assert greater or equal failed: unsupported data type.");
-}
 
-void assert_greater_equal_precision(long double  ge,
-                                     long double  le,
-                                     long double  epsilon,
-                                     char        *file,
-                                     int          line)
-{
-    if(fabsl(ge - le) > epsilon && ge < le)
+    for(int i = 0, first = 0; i < suite_count; first += suites[i].count, i++)
     {
-        register_fail(file, line, "Assert greater or equal failed: '%0.8Lf' is lesser than '%0.8Lf'.", ge, le);
+        int begin = first, end = first + suites[i].count;
+        while(begin < end && (*planned)[begin].skip)
+        {
+            begin++;
+        }
+        while(end > begin && (*planned)[end - 1].skip)
+        {
+            end--;
+        }
+        if(begin < end)
+        {
+            (*planned)[begin].setup_suite_fn = suites[i].setup_suite_fn;
+            (*planned)[begin].snapshot_setup_fn = suites[i].snapshot_setup_fn;
+            (*planned)[end - 1].teardown_suite_fn = suites[i].teardown_suite_fn;
+        }
     }
-}
 
-void assert_less_ch(const char lesser, const char greater, char *file, const int line)
-{
-    if(lesser >= greater)
+    int first = 0, last = test_count - 1;
+    while(first < test_count && (*planned)[first].skip)
     {
-        register_fail(file, line, "Assert less failed: '%c' is not lesser then '%c'.", lesser, greater);
+        first++;
     }
-}
-
-void assert_less_sch(const signed char lesser, const signed char greater, char *file, const int line)
-{
-    if(lesser >= greater)
+    while(last > first && (*planned)[last].skip)
     {
-        register_fail(file, line, "Assert less failed: '%c' is not lesser then '%c'.", lesser, greater);
+        last--;
     }
-}
-
-void assert_less_uch(const unsigned char lesser, const unsigned char greater, char *file, const int line)
-{
-    if(lesser >= greater)
+    if(first < test_count)
     {
-        register_fail(file, line, "Assert less failed: '%c' is not lesser then '%c'.", lesser, greater);
+        (*planned)[first].setup_environment = true;
+        (*planned)[last].teardown_environment = true;
     }
+
+    free(suite_of);
+    free(suites);
+    return test_count;
+
+error:
+    free(suite_of);
+    free(suites);
+    free(*planned);
+    free(environment.setup_fns);
+    free(environment.teardown_fns);
+    *planned = NULL;
+    return -1;
 }
 
-void assert_less_int(const intmax_t lesser, const intmax_t greater, char *file, const int line)
+/**
+ * Finds the accumulated results of the given suite, adding the suite if it has not been seen before.
+ *
+ * @param name The name of the suite.
+ * @return The results of the suite or @code NULL @endcode if out of memory.
+ */
+static struct suite_report *find_suite_report(const char *name)
 {
-    if(lesser >= greater)
+    // Tests of the same suite usually run one after the other.
+    for(size_t i = suite_reports.count; i > 0; i--)
     {
-        register_fail(file, line, "Assert less failed: '%ld' is not lesser then '%ld'.", lesser, greater);
+        if(strcmp(suite_reports.suites[i - 1].name, name) == 0)
+        {
+            return &suite_reports.suites[i - 1];
+        }
+    }
+    if(suite_reports.count == suite_reports.cap)
+    {
+        const size_t cap = suite_reports.cap == 0 ? 16 : 2 * suite_reports.cap;
+        struct suite_report *suites = realloc(suite_reports.suites, cap * sizeof(struct suite_report));
+        if(suites == NULL)
+        {
+            return NULL;
+        }
+        suite_reports.suites = suites;
+        suite_reports.cap = cap;
     }
+    struct suite_report *suite = &suite_reports.suites[suite_reports.count++];
+    suite->name    = name;
+    suite->tests   = 0;
+    suite->asserts = 0;
+    suite->time    = 0;
+    return suite;
 }
 
-void assert_less_uint(const uintmax_t lesser, const uintmax_t greater, char *file, const int line)
+/** Resets the failures of the current test, the memory is kept for the next failing test. */
+static void reset_failures(void)
 {
-    if(lesser >= greater)
+    // The failures received from a forked test process are not in the table.
+    if(failure_table.count > 0 || failures != NULL)
     {
-        register_fail(file, line, "Assert less failed: '%ld' is not lesser then '%ld'.", lesser, greater);
+        arena_reset(&failure_arena);
+        failure_table.generation++;
+        failure_table.count = 0;
+        failures = NULL;
+        failures_tail = &failures;
+        failure_count = 0;
     }
+    suppressed_count = 0;
+    eztest_assert_count = 0;
 }
 
 /**
- * Tests the equality of two floating point numbers.
- *
- * @param lesser  The value that is expected to be lesser.
- * @param greater The value that is expected to be greater.
- *
- * @remarks It is important to known that this test uses the epsilon macro from float.h
- *          in its equality test. It is therefore often better to use assert_greater_precision()
- *          and provide the application specific epsilon.
+ * Registers the current result by increasing the result counter
+ * and printing the result message.
  */
-void assert_less_dbl(const long double lesser, const long double greater, char *file, const int line)
+static void register_result(const unsigned int time)
 {
-    if(fabsl(greater - lesser) <= LDBL_EPSILON || lesser > greater)
+    // A forked test process sends the result to the runner process, which reports it.
+    if(result_pipe >= 0)
     {
-        register_fail(file, line, "Assert less failed: '%0.8Lf' is not lesser then '%0.8Lf'.", lesser, greater);
+        send_result(time);
+        fflush(NULL);
+        _exit(EXIT_SUCCESS);
     }
-}
 
-void assert_less_str(const char *lesser, const char *greater, char *file, const int line)
-{
-    if((greater == NULL && lesser != NULL) ||
-       (greater == NULL && lesser == NULL) ||
-       (greater != NULL && lesser != NULL && strcmp(lesser, greater) >= 0))
+    if(result == fail)
     {
-        register_fail(file, line, "Assert less failed: '%s' is not lesser then '%s'.", lesser, greater);
+        fail_count++;
+    }
+    else if(result == skip)
+    {
+        skip_count++;
+    }
+    else
+    {
+        result = pass;
+        pass_count++;
+        if(eztest_assert_count == 0)
+        {
+            empty_count++;
+        }
     }
-}
 
-void assert_less_wstr(const wchar_t *lesser, const wchar_t *greater, char *file, const int line)
-{
-    if((greater == NULL && lesser != NULL) ||
-       (greater == NULL && lesser == NULL) ||
-       (greater != NULL && lesser != NULL && wcscmp(lesser, greater) >= 0))
+    if(result != skip)
+    {
+        struct suite_report *suite = find_suite_report(current->test_suite);
+        if(suite != NULL)
+        {
+            suite->tests++;
+            suite->asserts += eztest_assert_count;
+            suite->time    += time;
+        }
+    }
+    total_assert_count += eztest_assert_count;
+
+    const struct test_report report = {
+        .result     = result,
+        .time       = time,
+        .failures   = failures,
+        .suppressed = suppressed_count,
+        .asserts    = eztest_assert_count
+    };
+    for(const struct failure *failure = failures; failure != NULL; failure = failure->next)
     {
-        register_fail(file, line, "Assert less failed: '%ls' is not lesser then '%ls'.", lesser, greater);
+        reporter->assert_fail(current, failure);
     }
+    reporter->test_end(current, &report);
+
+    snapshot_test_end(result == pass);
+    reset_failures();
 }
 
-/** Triggered when attempting to compare using an unsupported data type. */
-void assert_less(const void *lesser, const void *greater, char *file, const int line)
+/**
+ * Converts processor time to ms.
+ *
+ * @param t The processor time, as returned by clock.
+ * @return The time in ms.
+ */
+static unsigned int clock_ms(const clock_t t)
 {
-    register_fail(file, line, "Assert less failed: unsupported data type.");
+    return ((unsigned int)((((float)t) / CLOCKS_PER_SEC) * 1000));
 }
 
-void assert_less_precision(const long double  lesser,
-                            const long double  greater,
-                            const long double  epsilon,
-                            char              *file,
-                            const int          line)
+/**
+ * Runs the passed test with its setup and teardown functions.
+ *
+ * @param test The test to run.
+ */
+static void run_test(const struct unit_test *test)
 {
-    if(fabsl(lesser - greater) <= epsilon || lesser > greater)
+    if(test->setup_fn != NULL)
     {
-        register_fail(file, line, "Assert less failed: '%0.8Lf' is not lesser then '%0.8Lf'.", lesser, greater);
+        test->setup_fn();
     }
-}
-
-void assert_less_equal_ch(const char le, const char ge, char *file, const int line)
-{
-    if(le > ge)
+    if(test->run_param_fn != NULL)
     {
-        register_fail(file, line, "Assert less or equal failed: '%c' is greater then '%c'.", le, ge);
+        test->run_param_fn(test->params);
     }
-}
-
-void assert_less_equal_sch (const signed char le, const signed char ge, char *file, const int line)
-{
-    if(le > ge)
+    else
     {
-        register_fail(file, line, "Assert less or equal failed: '%c' is greater then '%c'.", le, ge);
+        test->run_fn();
     }
-}
-
-void assert_less_equal_uch (const unsigned char le, const unsigned char ge, char *file, const int line)
-{
-    if(le > ge)
+    if(test->teardown_fn != NULL)
     {
-        register_fail(file, line, "Assert less or equal failed: '%c' is greater then '%c'.", le, ge);
+        test->teardown_fn();
     }
+    arena_reset(&test_arena);
 }
 
-void assert_less_equal_int (const intmax_t le, const intmax_t ge, char *file, const int line)
+/**
+ * Reads a failure sent by a forked test process and adds it to the current test.
+ *
+ * @param offset The offset of the failure in the data, moved past it.
+ * @return On success @code EZTEST_RESULT_OK @endcode; otherwise @code EZTEST_RESULT_ERR @endcode
+ *         if the data ends before the failure.
+ */
+static int receive_failure(const char *data, const size_t size, size_t *offset)
 {
-    if(le > ge)
+    struct forked_failure sent;
+    if(size - *offset < sizeof(sent))
     {
-        register_fail(file, line, "Assert less or equal failed: '%ld' is greater then '%ld'.", le, ge);
+        return EZTEST_RESULT_ERR;
     }
-}
-
-void assert_less_equal_uint(const uintmax_t le, const uintmax_t ge, char *file, const int line)
-{
-    if(le > ge)
+    memcpy(&sent, data + *offset, sizeof(sent));
+    *offset += sizeof(sent);
+    if(size - *offset < sent.file_size || size - *offset - sent.file_size < sent.message_size)
+    {
+        return EZTEST_RESULT_ERR;
+    }
+    const char *sent_file = data + *offset;
+    const char *sent_message = sent_file + sent.file_size;
+    *offset += sent.file_size + sent.message_size;
+
+    struct failure *failure = arena_alloc(&failure_arena, sizeof(struct failure));
+    char *file    = arena_alloc(&failure_arena, sent.file_size + 1);
+    char *message = arena_alloc(&failure_arena, sent.message_size + 1);
+    if(failure == NULL || file == NULL || message == NULL)
     {
-        register_fail(file, line, "Assert less or equal failed: '%ld' is greater then '%ld'.", le, ge);
+        return EZTEST_RESULT_OK;
     }
+    memcpy(file, sent_file, sent.file_size);
+    file[sent.file_size] = '\0';
+    memcpy(message, sent_message, sent.message_size);
+    message[sent.message_size] = '\0';
+
+    // The message is already formatted, it is kept out of the failure table as it is never repeated.
+    failure->next       = NULL;
+    failure->file       = file;
+    failure->line       = sent.line;
+    failure->count      = 1;
+    failure->suppressed = false;
+    failure->fmt        = "%s%s";
+    failure->type       = operand_str;
+    failure->operands[0].str = message;
+    failure->operands[1].str = "";
+    *failures_tail = failure;
+    failures_tail = &failure->next;
+    failure_count++;
+    return EZTEST_RESULT_OK;
 }
 
 /**
- * Tests the equality of two floating point numbers.
- *
- * @param le The value that is expected to be lesser or equal to the second value.
- * @param ge The value that is expected to be greater than or equal to the first value.
+ * Reads a snapshot reached by a forked test process and records it, to be written to the snapshot file.
  *
- * @remarks It is important to known that this test uses the epsilon macro from float.h
- *          in its equality test. It is therefore often better to use assert_greater_equal_precision()
- *          and provide the application specific epsilon.
+ * @param offset The offset of the snapshot in the data, moved past it.
+ * @return On success @code EZTEST_RESULT_OK @endcode; otherwise @code EZTEST_RESULT_ERR @endcode
+ *         if the data ends before the snapshot.
  */
-void assert_less_equal_dbl(const long double le, const long double ge, char *file, const int line)
+static int receive_snapshot(const char *data, const size_t size, size_t *offset)
 {
-    if(fabsl(ge - le) > LDBL_EPSILON && le > ge)
+    struct forked_snapshot sent;
+    if(size - *offset < sizeof(sent))
     {
-        register_fail(file, line, "Assert less or equal failed: '%0.8Lf' is greater then '%0.8Lf'.", le, ge);
+        return EZTEST_RESULT_ERR;
     }
-}
-
-void assert_less_equal_str(const char *le, const char *ge, char *file, const int line)
-{
-    if((ge == NULL && le != NULL) ||
-       (ge != NULL && le != NULL && strcmp(le, ge) > 0))
+    memcpy(&sent, data + *offset, sizeof(sent));
+    *offset += sizeof(sent);
+    const size_t blocks_size = sent.blocks ? snapshot_block_count(sent.size) * sizeof(uint64_t) : 0;
+    if(size - *offset < sent.key_size || size - *offset - sent.key_size < blocks_size)
     {
-        register_fail(file, line, "Assert less or equal failed: '%s' is greater then '%s'.", le, ge);
+        return EZTEST_RESULT_ERR;
     }
-}
-
-void assert_less_equal_wstr(const wchar_t *le, const wchar_t *ge, char *file, const int line)
-{
-    if((ge == NULL && le != NULL) ||
-       (ge != NULL && le != NULL && wcscmp(le, ge) > 0))
+    const char *sent_key = data + *offset;
+    const char *sent_blocks = sent_key + sent.key_size;
+    *offset += sent.key_size + blocks_size;
+
+    snapshot_load();
+    char *key = malloc(sent.key_size + 1);
+    uint64_t *blocks = sent.blocks ? arena_alloc(&snapshots.arena, blocks_size + 1) : NULL;
+    struct snapshot *snapshot = NULL;
+    if(key != NULL && (blocks != NULL || !sent.blocks))
     {
-        register_fail(file, line, "Assert less or equal failed: '%ls' is greater then '%ls'.", le, ge);
+        memcpy(key, sent_key, sent.key_size);
+        key[sent.key_size] = '\0';
+        snapshot = snapshot_find(key, true);
     }
-}
-void assert_less_equal(const void *le, const void *ge, char *file, const int line)
-{
-    register_fail(file, line, "Assert less or equal failed: unsupported data type.");
-}
-
-void assert_less_equal_precision(const long double  le,
-                                  const long double  ge,
-                                  const long double  epsilon,
-                                  char              *file,
-                                  const int          line)
-{
-    if(fabsl(le - ge) > epsilon && le > ge)
+    free(key);
+    if(snapshot == NULL)
+    {
+        register_fail("SNAPSHOT", 0, operand_none, "Assert snapshot hash failed: out of memory.");
+        return EZTEST_RESULT_OK;
+    }
+    if(blocks != NULL)
+    {
+        memcpy(blocks, sent_blocks, blocks_size);
+    }
+    if(snapshot->hash != sent.hash || snapshot->size != sent.size || (snapshot->blocks != NULL) != sent.blocks ||
+       (blocks != NULL && memcmp(snapshot->blocks, blocks, blocks_size) != 0))
     {
-        register_fail(file, line, "Assert less or equal failed: '%0.8Lf' is greater then '%0.8Lf'.", le, ge);
+        snapshot->size   = sent.size;
+        snapshot->hash   = sent.hash;
+        snapshot->blocks = blocks;
+        snapshots.changed = true;
     }
+    snapshot->visited = true;
+    snapshot->dropped = false;
+    return EZTEST_RESULT_OK;
 }
 
-
-//endregion asserts
-
-//region runner
-
 /**
- * Discovers the unit test starting at the given address.
+ * Reads the records sent by a forked test process, adding its failures to the current test and
+ * recording its snapshots. The failures and snapshots sent before the process ended are kept
+ * even if it did not finish.
  *
- * @param base_test the starting address of which to start the discovery.
- * @return the amount of tests found.
+ * @param data The bytes read from the pipe.
+ * @param size The amount of bytes read.
+ * @param time Set to the execution time of the test in ms.
+ * @return On success @code EZTEST_RESULT_OK @endcode; otherwise @code EZTEST_RESULT_ERR @endcode
+ *         if the process ended before sending the result.
  */
-static int discover(struct unit_test **base_test)
+static int receive_result(const char *data, const size_t size, unsigned int *time)
 {
-    int count = 0;
-    struct unit_test *tmp = *base_test;
-
-    while(true)
+    size_t offset = 0;
+    enum forked_record kind;
+    while(size - offset >= sizeof(kind))
     {
-        if(tmp->marker == EZTEST_MARKER)
+        memcpy(&kind, data + offset, sizeof(kind));
+        offset += sizeof(kind);
+        switch(kind)
         {
-            if(strcmp(tmp->test_name, EZTEST_BASE_TEST_NAME) == 0)
+            case forked_failure_record:
+                if(receive_failure(data, size, &offset) != EZTEST_RESULT_OK)
+                {
+                    return EZTEST_RESULT_ERR;
+                }
+                break;
+
+            case forked_suppressed_record:
+                suppressed_count++;
+                break;
+
+            case forked_snapshot_record:
+                if(receive_snapshot(data, size, &offset) != EZTEST_RESULT_OK)
+                {
+                    return EZTEST_RESULT_ERR;
+                }
+                break;
+
+            case forked_result_record:
             {
-                (*base_test)++;
-                tmp++;
-                continue;
+                struct forked_result header;
+                if(size - offset < sizeof(header))
+                {
+                    return EZTEST_RESULT_ERR;
+                }
+                memcpy(&header, data + offset, sizeof(header));
+                offset += sizeof(header);
+                // The failures were sent when first registered, their repeats are counted at the end.
+                struct failure *failure = failures;
+                for(size_t i = 0; i < header.failures && failure != NULL; i++, failure = failure->next)
+                {
+                    if(size - offset < sizeof(failure->count))
+                    {
+                        return EZTEST_RESULT_ERR;
+                    }
+                    memcpy(&failure->count, data + offset, sizeof(failure->count));
+                    offset += sizeof(failure->count);
+                }
+                result              = header.result;
+                eztest_assert_count = header.asserts;
+                *time               = header.time;
+                return EZTEST_RESULT_OK;
             }
-            tmp++;
-            count++;
-        }
-        else
-        {
-            break;
+
+            default:
+                return EZTEST_RESULT_ERR;
         }
     }
-    if(!options->quiet)
-    {
-        printf("Test discovery finished, found %d tests.\n\n", count);
-    }
-    return count;
+    return EZTEST_RESULT_ERR;
 }
 
-static bool should_skip(const struct unit_test *test)
+/**
+ * Runs the passed test in a forked process, which shares the state of the runner process
+ * copy-on-write. The result is sent back through a pipe.
+ *
+ * @param test The test to run.
+ * @return The execution time of the test in ms.
+ */
+static unsigned int execute_forked(const struct unit_test *test)
 {
-    if(!options->skip || skip_list == NULL)
+    int fds[2];
+    if(pipe(fds) != 0)
     {
-        return false;
+        register_fail("FORK", errno, operand_str, "Could not run the test process: %s%s", strerror(errno), "");
+        return 0;
     }
-    char *skip_list_cp = malloc((strlen(skip_list) + 1) * sizeof(char));
-    if(skip_list_cp == NULL)
+    // Holds the output while forking, so that it is not copied while the flush thread writes it.
+    output_acquire();
+    output_flush();
+    fflush(NULL);
+    const pid_t pid = fork();
+    output_release();
+    if(pid < 0)
     {
-        return false;
+        register_fail("FORK", errno, operand_str, "Could not run the test process: %s%s", strerror(errno), "");
+        close(fds[0]);
+        close(fds[1]);
+        return 0;
     }
-    strcpy(skip_list_cp, skip_list);
- 
-    char *token;
-    token = strtok(skip_list_cp, separator);
-    while(token != NULL)
+    if(pid == 0)
     {
-        if(strcmp(token, test->test_suite) == 0)
+        close(fds[0]);
+        result_pipe = fds[1];
+        // The failures of the setup functions were registered before the pipe was opened.
+        for(const struct failure *failure = failures; failure != NULL; failure = failure->next)
         {
-            free(skip_list_cp);
-            return true;
+            send_failure(failure);
         }
-        token = strtok(NULL, separator);
+        for(size_t i = 0; i < suppressed_count; i++)
+        {
+            send_record(forked_suppressed_record);
+        }
+        const clock_t t = clock();
+        run_test(test);
+        register_result(clock_ms(clock() - t)); // Does not return.
     }
-    free(skip_list_cp);
 
-    return false;
-}
+    // The failures of the setup functions were copied to the test process, which sends them back.
+    close(fds[1]);
+    reset_failures();
 
-/**
- * Registers the current result by increasing the result counter
- * and printing the result message.
- */
-static void register_result(const unsigned int time)
-{
-    if(result == fail)
-    {
-        fail_count++;
-        print_failed(current, time);
-    }
-    else if(result == skip)
-    {
-        skip_count++;
-        print_skipped(current, time);
-    }
-    else
+    char *data = NULL;
+    size_t size = 0, cap = 0;
+    while(true)
     {
-        pass_count++;
-        print_passed(current, time);
+        if(size == cap)
+        {
+            cap = cap == 0 ? 4096 : 2 * cap;
+            char *tmp = realloc(data, cap);
+            if(tmp == NULL)
+            {
+                break;
+            }
+            data = tmp;
+        }
+        const ssize_t n = read(fds[0], data + size, cap - size);
+        if(n < 0 && errno == EINTR) continue;
+        if(n <= 0) break;
+        size += (size_t)n;
     }
-}
+    close(fds[0]);
 
-/**
- * Prints the total test time as long as the quiet options has not been set.
- * 
- * @param t The time 
- */
-static void print_test_time(const unsigned int t)
-{
-    if(options->quiet) return;
+    int status;
+    while(waitpid(pid, &status, 0) < 0 && errno == EINTR);
 
-    printf("Total elapsed time: %dms\n", t);
+    unsigned int time = 0;
+    if(receive_result(data, size, &time) != EZTEST_RESULT_OK)
+    {
+        if(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV)
+        {
+            register_fail("SIGNAL", SIGSEGV, operand_none, "Segmentation fault encountered.");
+        }
+        else if(WIFSIGNALED(status))
+        {
+            register_fail("SIGNAL", WTERMSIG(status), operand_int, "The test process was terminated by signal %jd.",
+                          (intmax_t)WTERMSIG(status), (intmax_t)0);
+        }
+        else
+        {
+            const int code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+            register_fail("EXIT", code, operand_int, "The test process exited with status %jd.",
+                          (intmax_t)code, (intmax_t)0);
+        }
+    }
+    free(data);
+    return time;
 }
 
 /**
- * Executes the passed test, running the setup and teardown functions
- * if they are not @code NULL @endcode
+ * Executes the passed test, running the environment, suite and test setup
+ * and teardown functions that are planned for it.
  *
- * @param test The test to run.
+ * @param planned The test to run.
  * @return The execution time in milliseconds.
  */
-static unsigned int execute(const struct unit_test *test)
+static unsigned int execute(const struct planned_test *planned)
 {
+    unsigned int forked_time = 0;
     clock_t t;
     t = clock();
-    if(test->setup_fn != NULL)
+    if(planned->setup_environment)
     {
-        test->setup_fn();
+        environment_setup();
     }
-    test->run_fn();
-    if(test->teardown_fn != NULL)
+    if(planned->setup_suite_fn != NULL)
     {
-        test->teardown_fn();
+        planned->setup_suite_fn();
+    }
+    if(planned->snapshot_setup_fn != NULL)
+    {
+        planned->snapshot_setup_fn();
+    }
+    if(planned->forked)
+    {
+        forked_time = execute_forked(planned->test);
+    }
+    else
+    {
+        run_test(planned->test);
+    }
+    if(planned->teardown_suite_fn != NULL)
+    {
+        planned->teardown_suite_fn();
+    }
+    if(planned->teardown_environment)
+    {
+        environment_teardown();
     }
     t = clock() - t;
-    return ((unsigned int)((((float)t) / CLOCKS_PER_SEC) * 1000));
+    return clock_ms(t) + forked_time;
 }
 
 /** To be executed on signal: SIGSEGV */
 static void onSegfault(int signum)
 {
-    register_fail("SIGNAL", signum, "Segmentation fault encountered.");
+    output_take_over();
+    register_fail("SIGNAL", signum, operand_none, "Segmentation fault encountered.");
     register_result(0);
+    output_flush();
 
-    signal(signum, SIG_DFL);
-    kill(getpid(), signum);
+    output_chain_signal(signum);
 }
 
 /**
@@ -2092,53 +9592,112 @@ int eztest_run(struct options *opts)
     
     options = opts;
     current = &EZTEST_STRUCT_NAME(eztest_base_suite, eztest_base_test);
+    reporter = options->quiet           ? &quiet_reporter
+             : options->reporter != NULL ? options->reporter
+             : &console_reporter;
+
+    if(output_open() != EZTEST_RESULT_OK)
+    {
+        return EZTEST_EXIT_FAILURE;
+    }
+    if(reporter == &console_reporter && options->progress && isatty(output_fd))
+    {
+        reporter = &progress_reporter;
+    }
     
     if(options->sigsegv)
     {
         signal(SIGSEGV, onSegfault);
     }
 
-    assert_buffer = malloc(ASSERT_BUFFER_SIZE);
-    if(assert_buffer == NULL)
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    property_seed = options->seed != 0 ? options->seed : xxh64(&now, sizeof(now), (uint64_t)getpid()) | 1;
+
+    struct planned_test *planned;
+    int count = plan(current, discover(&current), &planned);
+    if(count < 0)
     {
-        fprintf(stderr, "Failed to allocated memory for the assert buffer.");
+        output_close();
         return EZTEST_EXIT_FAILURE;
     }
-
-    const int count = discover(&current);
+    if(options->fuzz != NULL)
+    {
+        // Leaves out the other tests instead of reporting them as skipped.
+        int kept = 0;
+        for(int i = 0; i < count; i++)
+        {
+            if(!planned[i].skip)
+            {
+                planned[kept++] = planned[i];
+            }
+        }
+        count = kept;
+        if(count == 0)
+        {
+            fprintf(stderr, "Unknown fuzz test '%s'.\n", options->fuzz);
+            free(planned);
+            output_close();
+            return EZTEST_EXIT_FAILURE;
+        }
+    }
+    reporter->run_start(count);
 
     unsigned int test_time = 0; // Time for the current test.
     unsigned int total_time = 0; // Total time for all tests.
+    struct timespec start, end;  // Wall time of the run, used for the assert rate.
+    clock_gettime(CLOCK_MONOTONIC, &start);
 
-    for (int i = 0; i < count; i++, current++)
+    for (int i = 0; i < count; i++)
     {
-        if(should_skip(current))
+        current = planned[i].test;
+        reporter->test_start(current);
+        if(planned[i].skip)
         {
             result = skip;
+            test_time = 0;
         }
         else
         {
-            // Reset buffer
-            assert_buffer[0] = '\0';
-            assert_buffer_len = 0;
             // Reset result
             result = undefined; // Reset result before running new test.
             // Run test
-            test_time = execute(current);
+            output_release();
+            test_time = execute(&planned[i]);
+            output_acquire();
+            output_sync_stdout();
             total_time += test_time;
         }
         register_result(test_time);
     }
-    print_report();
-
-    if(options->timer)
-    {
-        print_test_time(total_time);
-    }
-
-    free(assert_buffer);
-
-    return fail_count;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    const struct run_report report = {
+        .pass        = pass_count,
+        .skip        = skip_count,
+        .fail        = fail_count,
+        .empty       = empty_count,
+        .time        = total_time,
+        .asserts     = total_assert_count,
+        .assert_rate = elapsed > 0 ? (double)total_assert_count / elapsed : 0,
+        .suites      = suite_reports.suites,
+        .suite_count = suite_reports.count
+    };
+    reporter->run_end(&report);
+
+    const int snapshot_result = snapshot_save();
+    free(planned);
+    free(environment.setup_fns);
+    free(environment.teardown_fns);
+    arena_free(&test_arena);
+    arena_free(&plan_arena);
+    arena_free(&failure_arena);
+    free(suite_reports.suites);
+    free(failure_table.slots);
+    output_close();
+
+    return snapshot_result == EZTEST_RESULT_OK ? fail_count : EZTEST_EXIT_FAILURE;
 }
 
 //endregion runner
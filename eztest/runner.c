@@ -8,6 +8,7 @@
 
 #define TEST_RUNNER
 
+#include "eztest.h" // First, so that its feature test macros apply to all system headers.
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdbool.h>
@@ -15,7 +16,8 @@
 #include <assert.h>
 #include <stdio.h>
 #include <locale.h>
-#include "eztest.h"
+#include <limits.h>
+#include <errno.h>
 
 /* Macros */
 
@@ -24,7 +26,11 @@
 #define __PROGRAM_AUTHOR__ "havardt"
 #define __PROGRAM_WEBSITE__ "https://github.com/havardt/EzTest"
 
-#define DEFAULT_OPTIONS { .no_color = false, .timer = false, .quiet = false, .skip = false, .sigsegv = false }
+#define DEFAULT_OPTIONS { .no_color = false, .timer = false, .quiet = false, .skip = false, .sigsegv = false,\
+                          .reporter = NULL, .output = NULL, .max_failures = 0,\
+                          .flag_empty = false, .progress = false, .update_golden = false,\
+                          .update_snapshots = false, .seed = 0, .property_cases = 0,\
+                          .fuzz = NULL }
 
 
 /* Prototypes */
@@ -44,6 +50,16 @@ const struct option long_opts[] = {
     {"quiet"   , no_argument      , NULL, 'q'},
     {"skip"    , required_argument, NULL, 's'},
     {"SIGSEGV" , no_argument      , NULL, 'f'},
+    {"reporter", required_argument, NULL, 'r'},
+    {"output"  , required_argument, NULL, 'o'},
+    {"max-failures", required_argument, NULL, 'm'},
+    {"flag-empty", no_argument    , NULL, 'e'},
+    {"progress", no_argument      , NULL, 'p'},
+    {"update-golden", no_argument , NULL, 'u'},
+    {"update-snapshots", no_argument, NULL, 'U'},
+    {"seed"    , required_argument, NULL, 'S'},
+    {"cases"   , required_argument, NULL, 'n'},
+    {"fuzz"    , required_argument, NULL, 'z'},
     {0}
 };
 
@@ -79,7 +95,17 @@ void print_usage(FILE *fd)
                 " -t  --timer     Display execution time for each test.\n"
                 " -q  --quiet     No output.\n"
                 " -s  --skip      Skips all tests in the passed list of test suits.\n"
-                " -f  --SIGSEGV   Segmentation fault is displayed like other test failures.\n\n",
+                " -f  --SIGSEGV   Segmentation fault is displayed like other test failures.\n"
+                " -r  --reporter  Selects the reporter used for output (console or binary).\n"
+                " -o  --output    Writes the output to the given file instead of stdout.\n"
+                " -m  --max-failures  Reports at most the given amount of failures for each test.\n"
+                " -e  --flag-empty    Flags passing tests that evaluated no asserts.\n"
+                " -p  --progress  Shows progress on a single line, only failed tests are printed.\n"
+                " -u  --update-golden Replaces golden files with the actual values instead of comparing them.\n"
+                " -U  --update-snapshots Records snapshot hashes instead of comparing them.\n"
+                " -S  --seed      Replays the property tests with the given seed.\n"
+                " -n  --cases     Runs the given amount of cases for each property test, or runs of the fuzz test.\n"
+                " -z  --fuzz      Fuzzes the given fuzz test (suite.name) until a failing input is found.\n\n",
                 __PROGRAM_NAME__);
 }
 
@@ -123,6 +149,79 @@ int parse_opt(struct options *opts, const int opt)
             opts->sigsegv = true;
             break;
 
+        case 'r':
+            opts->reporter = find_reporter(optarg);
+            if(opts->reporter == NULL)
+            {
+                fprintf(stderr, "Unknown reporter '%s'.\n", optarg);
+                return EZTEST_RESULT_ERR;
+            }
+            break;
+
+        case 'o':
+            opts->output = optarg;
+            break;
+
+        case 'p':
+            opts->progress = true;
+            break;
+
+        case 'e':
+            opts->flag_empty = true;
+            break;
+
+        case 'u':
+            opts->update_golden = true;
+            break;
+
+        case 'U':
+            opts->update_snapshots = true;
+            break;
+
+        case 'S':
+        {
+            char *end;
+            errno = 0;
+            const unsigned long long seed = strtoull(optarg, &end, 0);
+            if(*optarg == '\0' || *end != '\0' || errno != 0 || seed == 0)
+            {
+                fprintf(stderr, "Invalid seed '%s'.\n", optarg);
+                return EZTEST_RESULT_ERR;
+            }
+            opts->seed = (uint64_t)seed;
+            break;
+        }
+
+        case 'n':
+        {
+            char *end;
+            const unsigned long cases = strtoul(optarg, &end, 10);
+            if(*optarg == '\0' || *end != '\0' || cases == 0 || cases > UINT_MAX)
+            {
+                fprintf(stderr, "Invalid amount of cases '%s'.\n", optarg);
+                return EZTEST_RESULT_ERR;
+            }
+            opts->property_cases = (unsigned int)cases;
+            break;
+        }
+
+        case 'z':
+            opts->fuzz = optarg;
+            break;
+
+        case 'm':
+        {
+            char *end;
+            const unsigned long max = strtoul(optarg, &end, 10);
+            if(*optarg == '\0' || *end != '\0' || max > UINT_MAX)
+            {
+                fprintf(stderr, "Invalid max failures '%s'.\n", optarg);
+                return EZTEST_RESULT_ERR;
+            }
+            opts->max_failures = (unsigned int)max;
+            break;
+        }
+
         default:
             return EZTEST_RESULT_ERR;
     }
@@ -142,7 +241,7 @@ int parse_opt(struct options *opts, const int opt)
 int handle_opts(struct options *opts, const int argc, char **argv)
 {
     int opt, opt_index;
-    while((opt = getopt_long(argc, argv, "vhctqfs:", long_opts, &opt_index)) != -1)
+    while((opt = getopt_long(argc, argv, "vhctqfs:r:o:m:epuUS:n:z:", long_opts, &opt_index)) != -1)
     {
         if(parse_opt(opts, opt) != EZTEST_RESULT_OK)
         {
@@ -0,0 +1,49 @@
+/**
+ * Tests that fail on purpose, one suite for each behaviour of the runner checked by
+ * tests/runner_tests.c. They are not meant to be run on their own.
+ */
+#include "eztest.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+TEST(Collapse, Repeated)
+{
+    for(int i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(i, -1);
+    }
+    ASSERT_IS_TRUE(false);
+}
+
+SNAPSHOT_SETUP(Crash)
+{
+}
+
+TEST(Crash, Segfault)
+{
+    ASSERT_IS_TRUE(false);
+    volatile int *null = NULL;
+    *null = 1;
+}
+
+TEST(Crash, After)
+{
+    ASSERT_IS_TRUE(true);
+}
+
+PROPERTY(Shrink, Threshold, GEN_INT(0, 1000000))
+{
+    ASSERT_LT(args[0].i, 1000);
+}
+
+TEST(Snapshot, Vectors)
+{
+    // The reference vectors of XXH64 with seed 0, the third is changed to check the replay.
+    static const char *const inputs[] = { "", "a", "abc", "Nobody inspects the spammish repetition" };
+    for(size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+    {
+        const char *input = i == 2 && getenv("EZTEST_CASES_CHANGED") != NULL ? "abd" : inputs[i];
+        ASSERT_SNAPSHOT_HASH(input, strlen(input));
+    }
+}
@@ -0,0 +1,162 @@
+/**
+ * Tests of the runner, run by ctest. Each test runs one suite of tests/cases.c, whose tests fail
+ * on purpose, in a temporary directory and checks what the runner reports about it.
+ */
+#include "eztest.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifndef EZTEST_CASES
+#error "EZTEST_CASES must be the path of the binary built from tests/cases.c."
+#endif
+
+/** The size of the buffer for the output of a run. */
+#define CASES_OUTPUT_SIZE 16384
+
+/** The directory the cases run in, which holds their snapshot file. */
+static char directory[] = "/tmp/eztest_tests.XXXXXX";
+
+ENVIRONMENT_SETUP(Directory)
+{
+    ASSERT_IS_NOT_NULL(mkdtemp(directory));
+}
+
+ENVIRONMENT_TEARDOWN(Directory)
+{
+    char path[sizeof(directory) + sizeof("/eztest.snapshots")];
+    snprintf(path, sizeof(path), "%s/eztest.snapshots", directory);
+    unlink(path);
+    rmdir(directory);
+}
+
+/**
+ * Runs the cases of one suite, by skipping the others, without colors.
+ * @param suite The suite to run.
+ * @param arguments Further arguments of the runner.
+ * @param changed Whether the cases should change the data of their snapshots.
+ * @param output The buffer for the output of the run, stdout and stderr combined.
+ * @return The exit code of the run, -1 if it did not exit.
+ */
+static int run_cases(const char *suite, const char *arguments, const bool changed, char *output)
+{
+    static const char *const suites[] = { "Collapse", "Crash", "Shrink", "Snapshot" };
+    char skip[64] = "";
+    for(size_t i = 0; i < sizeof(suites) / sizeof(suites[0]); i++)
+    {
+        if(strcmp(suites[i], suite) != 0)
+        {
+            strcat(skip, skip[0] == '\0' ? "" : ",");
+            strcat(skip, suites[i]);
+        }
+    }
+
+    char command[1024];
+    snprintf(command, sizeof(command), "cd '%s' && %s'%s' -c -s %s %s 2>&1", directory,
+             changed ? "EZTEST_CASES_CHANGED=1 " : "", EZTEST_CASES, skip, arguments);
+    FILE *pipe = popen(command, "r");
+    if(pipe == NULL)
+    {
+        output[0] = '\0';
+        return -1;
+    }
+    const size_t length = fread(output, 1, CASES_OUTPUT_SIZE - 1, pipe);
+    output[length] = '\0';
+    const int status = pclose(pipe);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/** @return How often the given text occurs in the given output. */
+static int count_of(const char *output, const char *text)
+{
+    int count = 0;
+    for(const char *at = strstr(output, text); at != NULL; at = strstr(at + 1, text))
+    {
+        count++;
+    }
+    return count;
+}
+
+/** @return Whether a line of the given output contains both of the given texts. */
+static bool has_line(const char *output, const char *first, const char *second)
+{
+    for(const char *at = strstr(output, first); at != NULL; at = strstr(at + 1, first))
+    {
+        const char *start = at;
+        while(start > output && start[-1] != '\n')
+        {
+            start--;
+        }
+        const char *end = strchr(at, '\n');
+        const char *found = strstr(start, second);
+        if(found != NULL && (end == NULL || found < end))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST(Runner, CollapsesRepeatedFailures)
+{
+    char output[CASES_OUTPUT_SIZE];
+    ASSERT_EQ(run_cases("Collapse", "", false, output), 1);
+    ASSERT_EQ(count_of(output, "Assert are equal failed: expected '0', but got '-1'."), 1);
+    ASSERT_EQ(count_of(output, "(failed 3 times)"), 1);
+    ASSERT_IS_TRUE(has_line(output, "line 14", "(failed 3 times)"));
+    // A different assert is reported on its own.
+    ASSERT_EQ(count_of(output, "Assert is true failed."), 1);
+    ASSERT_IS_FALSE(has_line(output, "line 16", "(failed"));
+}
+
+TEST(Runner, ReportsForkedCrashes)
+{
+    char output[CASES_OUTPUT_SIZE];
+    ASSERT_EQ(run_cases("Crash", "", false, output), 1);
+    ASSERT_IS_TRUE(has_line(output, "FAILED", "Crash : Segfault"));
+    // The failure before the crash is kept, and the crash does not take the runner down.
+    ASSERT_IS_TRUE(has_line(output, "Assert is true failed.", ""));
+    ASSERT_EQ(count_of(output, "Segmentation fault encountered."), 1);
+    ASSERT_IS_TRUE(has_line(output, "PASSED", "Crash : After"));
+}
+
+TEST(Runner, ShrinksPropertyFailures)
+{
+    char output[CASES_OUTPUT_SIZE];
+    ASSERT_EQ(run_cases("Shrink", "-S 1", false, output), 1);
+    ASSERT_IS_TRUE(has_line(output, "Property failed:", "replay with --seed=1."));
+    ASSERT_IS_TRUE(has_line(output, "Shrunk", "times to:"));
+    ASSERT_IS_TRUE(has_line(output, "args[0] = 1000", ""));
+    ASSERT_IS_TRUE(has_line(output, "Assert less failed:", "'1000' is not lesser then '1000'."));
+}
+
+TEST(Runner, RecordsAndReplaysSnapshots)
+{
+    char output[CASES_OUTPUT_SIZE];
+    ASSERT_EQ(run_cases("Snapshot", "-U", false, output), 0);
+
+    // The recorded hashes are the reference vectors of XXH64.
+    char path[sizeof(directory) + sizeof("/eztest.snapshots")];
+    snprintf(path, sizeof(path), "%s/eztest.snapshots", directory);
+    FILE *file = fopen(path, "r");
+    ASSERT_IS_NOT_NULL(file);
+    if(file == NULL)
+    {
+        return;
+    }
+    const size_t length = fread(output, 1, CASES_OUTPUT_SIZE - 1, file);
+    output[length] = '\0';
+    fclose(file);
+    ASSERT_IS_TRUE(has_line(output, "Snapshot.Vectors\t1\t0\t", "ef46db3751d8e999"));
+    ASSERT_IS_TRUE(has_line(output, "Snapshot.Vectors\t2\t1\t", "d24ec4f1a98c6e5b"));
+    ASSERT_IS_TRUE(has_line(output, "Snapshot.Vectors\t3\t3\t", "44bc2cf5ad770999"));
+    ASSERT_IS_TRUE(has_line(output, "Snapshot.Vectors\t4\t39\t", "fbcea83c8a378bf1"));
+
+    // Replaying the same data passes, changed data fails against the recorded hash.
+    ASSERT_EQ(run_cases("Snapshot", "", false, output), 0);
+    ASSERT_EQ(run_cases("Snapshot", "", true, output), 1);
+    ASSERT_IS_TRUE(has_line(output, "Assert snapshot hash failed:", "expected 44bc2cf5ad770999 (3 bytes)"));
+}